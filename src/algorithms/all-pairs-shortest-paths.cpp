@@ -0,0 +1,155 @@
+#include "all-pairs-shortest-paths.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "graph-algorithms.h"
+#include "parallel.h"
+
+/*
+ * Floyd-Warshall tiles are TILE by TILE, 16 KiB of int32_t. Unreachable entries hold UNREACHABLE, and sums saturate 
+ * there, so a path costing INT32_MAX or more counts as unreachable, as in singleSourceShortestPath.
+*/
+constexpr size_t TILE = 64;
+constexpr int32_t INFINITE_COST = DistanceMatrix::UNREACHABLE;
+
+/**
+ * @brief One Floyd-Warshall step over a tile: c[i][j] = min(c[i][j], a[i][k] + b[k][j]) for every k of the tile. a, b 
+ * and c point to the top left of their tiles in a matrix whose rows are stride apart, and may be the same tile.
+ */
+void relaxTile(int32_t* c, const int32_t* a, const int32_t* b, size_t stride) {
+    for (size_t k = 0; k < TILE; k++) {
+        // A local copy of row k cannot alias row i, which lets the inner loop be vectorized.
+        int32_t rowK[TILE];
+        std::memcpy(rowK, b + k * stride, sizeof(rowK));
+        for (size_t i = 0; i < TILE; i++) {
+            int32_t costIK = a[i * stride + k];
+            if (costIK == INFINITE_COST)
+                continue;
+
+            // Sums saturate instead of overflowing, with selects rather than branches to keep the loops vectorizable. 
+            // A cost that is not negative can only overflow upwards, from rowK[j] = upper on, which includes an 
+            // unreachable rowK[j]. A negative one can only overflow downwards, below lower, but must still leave 
+            // infinity alone.
+            int32_t* rowI = c + i * stride;
+            if (costIK >= 0) {
+                const int32_t upper = INFINITE_COST - costIK;
+                for (size_t j = 0; j < TILE; j++) {
+                    int32_t sum = (rowK[j] >= upper) ? INFINITE_COST : costIK + rowK[j];
+                    rowI[j] = std::min(rowI[j], sum);
+                }
+            } else {
+                const int32_t lower = INT32_MIN - costIK;
+                for (size_t j = 0; j < TILE; j++) {
+                    int32_t sum = (rowK[j] < lower) ? INT32_MIN : costIK + rowK[j];
+                    rowI[j] = std::min(rowI[j], (rowK[j] == INFINITE_COST) ? INFINITE_COST : sum);
+                }
+            }
+        }
+    }
+}
+
+template <typename G>
+DistanceMatrix floydWarshall_t(const G& graph, unsigned int threadCount) {
+    const size_t n = graph.vertexCount();
+    const size_t tiles = (n + TILE - 1) / TILE;
+    const size_t stride = tiles * TILE;
+
+    // Padded to whole tiles. Padding vertices have no edges, so they never shorten a path.
+    std::vector<int32_t> matrix(stride * stride, INFINITE_COST);
+    for (size_t i = 0; i < stride; i++)
+        matrix[i * stride + i] = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        for (CompactEdge edge : graph.getEdges(i)) {
+            int32_t& cost = matrix[i * stride + edge.target];
+            cost = std::min(cost, edge.weight);
+        }
+    }
+
+    auto tile = [&](size_t row, size_t column) { return matrix.data() + (row * stride + column) * TILE; };
+    for (size_t k = 0; k < tiles; k++) {
+        int32_t* diagonal = tile(k, k);
+        relaxTile(diagonal, diagonal, diagonal, stride);
+
+        // Tiles in row k and column k only depend on the diagonal tile and themselves.
+        parallelFor(2 * (tiles - 1), threadCount, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t t = begin; t < end; t++) {
+                size_t other = t / 2 + (t / 2 >= k);
+                if (t % 2 == 0)
+                    relaxTile(tile(k, other), diagonal, tile(k, other), stride);
+                else
+                    relaxTile(tile(other, k), tile(other, k), diagonal, stride);
+            }
+        });
+
+        // Every other tile depends on its row's tile in column k and its column's tile in row k.
+        parallelFor((tiles - 1) * (tiles - 1), threadCount, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t t = begin; t < end; t++) {
+                size_t row = t / (tiles - 1);
+                size_t column = t % (tiles - 1);
+                row += (row >= k);
+                column += (column >= k);
+                relaxTile(tile(row, column), tile(row, k), tile(k, column), stride);
+            }
+        });
+    }
+
+    // Drop the padding, moving rows forward in place.
+    DistanceMatrix result;
+    result.vertexCount = n;
+    for (size_t i = 0; i < n; i++)
+        std::memmove(matrix.data() + i * n, matrix.data() + i * stride, n * sizeof(int32_t));
+    matrix.resize(n * n);
+    matrix.shrink_to_fit();
+    result.distances = std::move(matrix);
+    return result;
+}
+
+template <typename G>
+DistanceMatrix repeatedDijkstra_t(const G& graph, unsigned int threadCount) {
+    const size_t n = graph.vertexCount();
+    DistanceMatrix result;
+    result.vertexCount = n;
+    result.distances.resize(n * n);
+
+    parallelFor(n, threadCount, [&](size_t begin, size_t end, unsigned int) {
+        DijkstraWorkspace workspace;
+        for (size_t origin = begin; origin < end; origin++) {
+            const std::vector<DenseDijkstraInfo>& table = singleSourceShortestPath(graph, origin, workspace);
+            int32_t* row = result.distances.data() + origin * n;
+            for (size_t i = 0; i < n; i++)
+                row[i] = table[i].cost;
+        }
+    });
+    return result;
+}
+
+template <typename G>
+DistanceMatrix allPairsShortestPaths_t(const G& graph, ApspMethod method, unsigned int threadCount) {
+    threadCount = resolveThreadCount(threadCount);
+    if (method == ApspMethod::automatic) {
+        // Floyd-Warshall does about V^3 / 16 vectorized steps; V Dijkstra runs do about V E log V heap and cache 
+        // missing ones.
+        double n = graph.vertexCount();
+        double adjacencies = 0;
+        for (uint32_t i = 0; i < graph.vertexCount(); i++)
+            adjacencies += graph.getEdges(i).size();
+        bool dense = n * n < 16 * adjacencies * std::log2(std::max(2.0, n));
+        method = dense ? ApspMethod::floydWarshall : ApspMethod::repeatedDijkstra;
+    }
+
+    if (method == ApspMethod::floydWarshall)
+        return floydWarshall_t(graph, threadCount);
+    return repeatedDijkstra_t(graph, threadCount);
+}
+
+DistanceMatrix allPairsShortestPaths(const CompactGraph& graph, ApspMethod method, unsigned int threadCount) {
+    return allPairsShortestPaths_t(graph, method, threadCount);
+}
+
+DistanceMatrix allPairsShortestPaths(const CsrGraph& graph, ApspMethod method, unsigned int threadCount) {
+    return allPairsShortestPaths_t(graph, method, threadCount);
+}
+
+DistanceMatrix allPairsShortestPaths(const CompressedGraph& graph, ApspMethod method, unsigned int threadCount) {
+    return allPairsShortestPaths_t(graph, method, threadCount);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+
+/**
+ * @brief How to compute all pairs shortest paths.
+ * 
+ * automatic: floydWarshall for dense graphs, repeatedDijkstra for sparse ones.
+ * 
+ * floydWarshall: blocked Floyd-Warshall over the whole matrix, O(V^3). Handles negative weights as long as there are 
+ * no negative cycles and no shortest path costs less than INT32_MIN.
+ * 
+ * repeatedDijkstra: one single source search per vertex, O(V (V + E) log V). Weights must not be negative.
+ */
+enum ApspMethod {automatic, floydWarshall, repeatedDijkstra};
+
+/**
+ * @brief Shortest path costs between every pair of vertices, row by row: the cost from a to b is at 
+ * distances[a * vertexCount + b]. Unreachable pairs have a cost of UNREACHABLE.
+ */
+struct DistanceMatrix {
+    constexpr static int32_t UNREACHABLE = INT32_MAX;
+
+    uint32_t vertexCount;
+    std::vector<int32_t> distances;
+
+    int32_t get(uint32_t from, uint32_t to) const { return distances[size_t(from) * vertexCount + to]; }
+};
+
+/**
+ * @brief Computes the shortest path cost between every pair of vertices, split over several threads. 
+ * 
+ * Floyd-Warshall works on 64 by 64 tiles that fit in the L1 cache, in the usual three phases per diagonal tile: the 
+ * diagonal tile itself, then the tiles in its row and column, then all the others, where the tiles of each of the last 
+ * two phases are independent and shared among threads. The inner min-plus loop runs over a fixed width row so the 
+ * compiler can vectorize it. Sums saturate at UNREACHABLE, so costs are exact below INT32_MAX and a pair whose shortest 
+ * path costs INT32_MAX or more is reported as unreachable, as singleSourceShortestPath does. Both methods give the same 
+ * matrix.
+ * 
+ * The repeated Dijkstra method gives each thread its own DijkstraWorkspace and a share of the origins.
+ * 
+ * @param graph source graph
+ * @param method which algorithm to use
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @return DistanceMatrix the cost of every pair, V^2 entries
+ */
+DistanceMatrix allPairsShortestPaths(const CompactGraph& graph, ApspMethod method = ApspMethod::automatic, 
+        unsigned int threadCount = 0);
+
+/**
+ * @brief See allPairsShortestPaths(const CompactGraph&, ...).
+ */
+DistanceMatrix allPairsShortestPaths(const CsrGraph& graph, ApspMethod method = ApspMethod::automatic, 
+        unsigned int threadCount = 0);
+
+/**
+ * @brief See allPairsShortestPaths(const CompactGraph&, ...). Adjacency lists are decoded on the fly.
+ */
+DistanceMatrix allPairsShortestPaths(const CompressedGraph& graph, ApspMethod method = ApspMethod::automatic, 
+        unsigned int threadCount = 0);
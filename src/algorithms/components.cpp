@@ -0,0 +1,226 @@
+#include "components.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <utility>
+#include <unordered_map>
+#include "parallel.h"
+
+/*
+ * How many neighbours of each vertex are joined before sampling, and how many vertices the sample has.
+*/
+constexpr uint32_t AFFOREST_NEIGHBOUR_ROUNDS = 2;
+constexpr uint32_t AFFOREST_SAMPLE_SIZE = 1024;
+
+/**
+ * @brief Counts the vertices of each component.
+ */
+void countSizes(Components& components) {
+    components.sizes.assign(components.count, 0);
+    for (uint32_t id : components.ids)
+        components.sizes[id]++;
+}
+
+/**
+ * @brief Afforest's union: hooks the higher of two roots under the lower one with a compare-and-swap, walking up 
+ * again if another thread moved either root first. Labels only ever decrease, so no cycle can form.
+ */
+void linkLabels(std::vector<std::atomic<uint32_t>>& labels, uint32_t u, uint32_t v) {
+    uint32_t labelU = labels[u].load(std::memory_order_relaxed);
+    uint32_t labelV = labels[v].load(std::memory_order_relaxed);
+    while (labelU != labelV) {
+        uint32_t high = std::max(labelU, labelV);
+        uint32_t low = std::min(labelU, labelV);
+        uint32_t highLabel = labels[high].load(std::memory_order_relaxed);
+        if (highLabel == low)
+            break;
+        if (highLabel == high && labels[high].compare_exchange_strong(highLabel, low, std::memory_order_relaxed))
+            break;
+        labelU = labels[labels[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+        labelV = labels[low].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Points every vertex straight at its root, so the next pass finds roots with a single load.
+ */
+void compressLabels(std::vector<std::atomic<uint32_t>>& labels, unsigned int threads) {
+    parallelFor(labels.size(), threads, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t vertex = begin; vertex < end; vertex++) {
+            uint32_t label = labels[vertex].load(std::memory_order_relaxed);
+            uint32_t parent = labels[label].load(std::memory_order_relaxed);
+            while (label != parent) {
+                label = parent;
+                parent = labels[label].load(std::memory_order_relaxed);
+            }
+            labels[vertex].store(label, std::memory_order_relaxed);
+        }
+    });
+}
+
+template <typename G>
+Components connectedComponents_t(const G& graph, unsigned int threadCount) {
+    const uint32_t n = graph.vertexCount();
+    const unsigned int threads = resolveThreadCount(threadCount);
+    const bool directed = graph.getType() == GraphType::directed;
+
+    // Each vertex's label leads to its root; a root is its own label.
+    std::vector<std::atomic<uint32_t>> labels(n);
+    parallelFor(n, threads, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t vertex = begin; vertex < end; vertex++)
+            labels[vertex].store(vertex, std::memory_order_relaxed);
+    });
+
+    // Round r joins each vertex to its r-th neighbour. Compressing between rounds keeps every walk to a root short.
+    for (uint32_t round = 0; round < AFFOREST_NEIGHBOUR_ROUNDS; round++) {
+        parallelFor(n, threads, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t vertex = begin; vertex < end; vertex++) {
+                uint32_t index = 0;
+                for (CompactEdge edge : graph.getEdges(vertex)) {
+                    if (index++ == round) {
+                        linkLabels(labels, vertex, edge.target);
+                        break;
+                    }
+                }
+            }
+        });
+        compressLabels(labels, threads);
+    }
+
+    uint32_t largest = CompactGraph::NO_VERTEX;
+    if (n > 0) {
+        std::mt19937 random(n);
+        std::unordered_map<uint32_t, uint32_t> rootCounts;
+        uint32_t largestCount = 0;
+        for (uint32_t i = 0; i < AFFOREST_SAMPLE_SIZE; i++) {
+            uint32_t root = labels[random() % n].load(std::memory_order_relaxed);
+            uint32_t count = ++rootCounts[root];
+            if (count > largestCount) {
+                largestCount = count;
+                largest = root;
+            }
+        }
+    }
+
+    // A vertex in the largest set can skip its other edges: each of them either stays inside the set or is seen from 
+    // its other end, which is outside it. Out-edges of a directed graph are only seen from one end, so vertices 
+    // outside the set go through their in-edges too.
+    parallelFor(n, threads, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t vertex = begin; vertex < end; vertex++) {
+            if (labels[vertex].load(std::memory_order_relaxed) == largest)
+                continue;
+            uint32_t index = 0;
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                if (index++ >= AFFOREST_NEIGHBOUR_ROUNDS)
+                    linkLabels(labels, vertex, edge.target);
+            }
+            if (directed) {
+                for (CompactEdge edge : graph.getInEdges(vertex))
+                    linkLabels(labels, vertex, edge.target);
+            }
+        }
+    });
+    compressLabels(labels, threads);
+
+    // Roots are the lowest id of their component, so numbering roots in id order numbers components by lowest id.
+    Components components;
+    components.ids.resize(n);
+    components.count = 0;
+    for (uint32_t vertex = 0; vertex < n; vertex++) {
+        uint32_t root = labels[vertex].load(std::memory_order_relaxed);
+        components.ids[vertex] = (root == vertex) ? components.count++ : components.ids[root];
+    }
+    countSizes(components);
+    return components;
+}
+
+template <typename G>
+struct TarjanFrame {
+    using EdgeIterator = decltype(std::declval<const G&>().getEdges(0).begin());
+
+    uint32_t vertex;
+    EdgeIterator next;
+    EdgeIterator end;
+};
+
+template <typename G>
+Components stronglyConnectedComponents_t(const G& graph) {
+    const uint32_t n = graph.vertexCount();
+    const uint32_t UNVISITED = UINT32_MAX;
+    Components components;
+    components.ids.assign(n, CompactGraph::NO_VERTEX);
+    components.count = 0;
+
+    // A vertex is on Tarjan's stack exactly when it has been visited but has no component yet.
+    std::vector<uint32_t> indices(n, UNVISITED);
+    std::vector<uint32_t> lowLinks(n);
+    std::vector<uint32_t> visited;
+    std::vector<TarjanFrame<G>> stack;
+    uint32_t nextIndex = 0;
+
+    for (uint32_t root = 0; root < n; root++) {
+        if (indices[root] != UNVISITED)
+            continue;
+        indices[root] = lowLinks[root] = nextIndex++;
+        visited.push_back(root);
+        stack.push_back({root, graph.getEdges(root).begin(), graph.getEdges(root).end()});
+
+        while (!stack.empty()) {
+            TarjanFrame<G>& frame = stack.back();
+            const uint32_t vertex = frame.vertex;
+            if (frame.next != frame.end) {
+                uint32_t target = (*frame.next).target;
+                ++frame.next;
+                if (indices[target] == UNVISITED) {
+                    indices[target] = lowLinks[target] = nextIndex++;
+                    visited.push_back(target);
+                    stack.push_back({target, graph.getEdges(target).begin(), graph.getEdges(target).end()});
+                } else if (components.ids[target] == CompactGraph::NO_VERTEX && indices[target] < lowLinks[vertex]) {
+                    lowLinks[vertex] = indices[target];
+                }
+                continue;
+            }
+
+            // Every vertex reachable from this one has been visited. If none of them leads back above it, it and the 
+            // vertices visited after it form a component.
+            if (lowLinks[vertex] == indices[vertex]) {
+                uint32_t member;
+                do {
+                    member = visited.back();
+                    visited.pop_back();
+                    components.ids[member] = components.count;
+                } while (member != vertex);
+                components.count++;
+            }
+            stack.pop_back();
+            if (!stack.empty() && lowLinks[vertex] < lowLinks[stack.back().vertex])
+                lowLinks[stack.back().vertex] = lowLinks[vertex];
+        }
+    }
+    countSizes(components);
+    return components;
+}
+
+Components connectedComponents(const CompactGraph& graph, unsigned int threadCount) {
+    return connectedComponents_t(graph, threadCount);
+}
+
+Components connectedComponents(const CsrGraph& graph, unsigned int threadCount) {
+    return connectedComponents_t(graph, threadCount);
+}
+
+Components connectedComponents(const CompressedGraph& graph, unsigned int threadCount) {
+    return connectedComponents_t(graph, threadCount);
+}
+
+Components stronglyConnectedComponents(const CompactGraph& graph) {
+    return stronglyConnectedComponents_t(graph);
+}
+
+Components stronglyConnectedComponents(const CsrGraph& graph) {
+    return stronglyConnectedComponents_t(graph);
+}
+
+Components stronglyConnectedComponents(const CompressedGraph& graph) {
+    return stronglyConnectedComponents_t(graph);
+}
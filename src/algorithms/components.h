@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+
+/**
+ * @brief A partition of the vertices into components. ids holds the component of every vertex, numbered densely from 
+ * 0 to count - 1, and sizes holds how many vertices each component has. Two vertices are connected exactly when they 
+ * have the same id.
+ */
+struct Components {
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> sizes;
+    uint32_t count;
+};
+
+/**
+ * @brief Connected components, ignoring edge direction (weakly connected components of a directed graph). Components 
+ * are numbered in order of their lowest vertex id.
+ * 
+ * Afforest (Sutton, Ben-Nun and Barak): every vertex keeps a label leading to the lowest id of its tree. Each vertex 
+ * is first hooked to its first two neighbours, which already links most of any large component. The largest tree is 
+ * then found from a sample of vertices, and only vertices outside it go through the rest of their edges, so most 
+ * edges of the giant component are never looked at. Every pass is split over threads.
+ * 
+ * @param graph source graph
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @return Components the component of every vertex
+ */
+Components connectedComponents(const CompactGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See connectedComponents(const CompactGraph&, unsigned int).
+ */
+Components connectedComponents(const CsrGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See connectedComponents(const CompactGraph&, unsigned int).
+ */
+Components connectedComponents(const CompressedGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief Strongly connected components: two vertices share a component when each can reach the other along out-edges. 
+ * Tarjan's algorithm with an explicit stack, so very deep graphs cannot overflow the call stack. O(V + E).
+ * 
+ * Components are numbered in reverse topological order of the graph of components: every edge between two 
+ * components leads from a higher id to a lower one, and component 0 has no edges out. For an undirected graph these 
+ * are its connected components.
+ * 
+ * @param graph source graph
+ * @return Components the component of every vertex
+ */
+Components stronglyConnectedComponents(const CompactGraph& graph);
+
+/**
+ * @brief See stronglyConnectedComponents(const CompactGraph&).
+ */
+Components stronglyConnectedComponents(const CsrGraph& graph);
+
+/**
+ * @brief See stronglyConnectedComponents(const CompactGraph&).
+ */
+Components stronglyConnectedComponents(const CompressedGraph& graph);
@@ -0,0 +1,461 @@
+#include "contraction-hierarchy.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+constexpr char HIERARCHY_FILE_MAGIC[8] = {'D', 'S', 'A', 'C', 'H', 'I', 'E', 'R'};
+constexpr uint32_t HIERARCHY_FILE_VERSION = 1;
+
+/*
+ * Witness searches give up after settling this many vertices and assume there is no witness, which only costs an 
+ * unneeded shortcut.
+*/
+constexpr uint32_t WITNESS_SETTLE_LIMIT = 500;
+
+/**
+ * @brief Contracts a graph. The remaining graph is kept as an out list and an in list per vertex, holding only 
+ * vertices not contracted yet, with at most one arc per pair.
+ */
+class HierarchyBuilder {
+public:
+    uint32_t n;
+    std::vector<std::vector<HierarchyArc>> out;
+    std::vector<std::vector<HierarchyArc>> in;
+    std::vector<bool> contracted;
+    std::vector<uint32_t> contractedNeighbours;
+    std::vector<uint32_t> depth;
+
+    // Witness search state, reset through touched. A vertex is a target of the current search while its stamp matches.
+    std::vector<int> costs;
+    std::vector<uint32_t> touched;
+    IndexedHeap<int> heap;
+    std::vector<uint32_t> targetStamps;
+    uint32_t stamp;
+
+    explicit HierarchyBuilder(const CsrGraph& graph) : n(graph.vertexCount()), out(n), in(n), contracted(n, false), 
+            contractedNeighbours(n, 0), depth(n, 0), costs(n, INT32_MAX), heap(n), targetStamps(n, 0), stamp(0) {
+        for (uint32_t vertex = 0; vertex < n; vertex++) {
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                if (edge.weight < 0)
+                    throw std::invalid_argument("Contraction hierarchies need non-negative weights.");
+                if (edge.target != vertex)
+                    addArc(vertex, edge.target, edge.weight, CompactGraph::NO_VERTEX);
+            }
+        }
+    }
+
+    /**
+     * @brief Adds an arc, or lowers the weight of the one already there.
+     */
+    void addArc(uint32_t from, uint32_t to, int32_t weight, uint32_t middle) {
+        for (HierarchyArc& arc : out[from]) {
+            if (arc.other == to) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (HierarchyArc& reverse : in[to]) {
+                        if (reverse.other == from) {
+                            reverse.weight = weight;
+                            reverse.middle = middle;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        out[from].push_back({to, weight, middle});
+        in[to].push_back({from, weight, middle});
+    }
+
+    /**
+     * @brief Dijkstra from source, not passing through avoid, until every vertex within maxCost or every one of 
+     * avoid's out-neighbours is settled, or the settle limit is reached. Leaves the costs found in costs.
+     */
+    void witnessSearch(uint32_t source, uint32_t avoid, int64_t maxCost) {
+        stamp++;
+        uint32_t targetsLeft = 0;
+        for (const HierarchyArc& arc : out[avoid]) {
+            if (arc.other != source) {
+                targetStamps[arc.other] = stamp;
+                targetsLeft++;
+            }
+        }
+
+        for (uint32_t vertex : touched)
+            costs[vertex] = INT32_MAX;
+        touched.clear();
+        heap.clear();
+
+        costs[source] = 0;
+        touched.push_back(source);
+        heap.insert(source, 0);
+        uint32_t settled = 0;
+        while (heap.getCount() > 0 && heap.getMinKey() <= maxCost && settled++ < WITNESS_SETTLE_LIMIT) {
+            uint32_t vertex = heap.extractMin();
+            if (targetStamps[vertex] == stamp && --targetsLeft == 0)
+                break;
+            for (const HierarchyArc& arc : out[vertex]) {
+                if (arc.other == avoid)
+                    continue;
+                int64_t newCost = int64_t(costs[vertex]) + arc.weight;
+                if (newCost < costs[arc.other]) {
+                    if (costs[arc.other] == INT32_MAX)
+                        touched.push_back(arc.other);
+                    costs[arc.other] = newCost;
+                    heap.insertOrDecrease(arc.other, newCost);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the shortcuts contracting a vertex needs, adding them unless simulating.
+     * 
+     * @return uint32_t how many shortcuts are needed
+     */
+    uint32_t contract(uint32_t vertex, bool simulate) {
+        int32_t maxOut = 0;
+        for (const HierarchyArc& arc : out[vertex])
+            maxOut = std::max(maxOut, arc.weight);
+
+        uint32_t shortcuts = 0;
+        std::vector<HierarchyArc> inArcs = in[vertex];
+        for (const HierarchyArc& incoming : inArcs) {
+            witnessSearch(incoming.other, vertex, int64_t(incoming.weight) + maxOut);
+            for (const HierarchyArc& outgoing : out[vertex]) {
+                if (outgoing.other == incoming.other)
+                    continue;
+                // A shortcut of INT32_MAX or more could never be part of a path a query can report.
+                int64_t viaVertex = int64_t(incoming.weight) + outgoing.weight;
+                if (costs[outgoing.other] <= viaVertex || viaVertex >= INT32_MAX)
+                    continue;
+                shortcuts++;
+                if (!simulate)
+                    addArc(incoming.other, outgoing.other, viaVertex, vertex);
+            }
+        }
+        return shortcuts;
+    }
+
+    int priority(uint32_t vertex) {
+        int edgeDifference = int(contract(vertex, true)) - int(in[vertex].size() + out[vertex].size());
+        return 2 * edgeDifference + int(contractedNeighbours[vertex]) + int(depth[vertex]);
+    }
+
+    /**
+     * @brief Removes a contracted vertex from the lists of its neighbours, which now all rank above it.
+     */
+    void detach(uint32_t vertex) {
+        contracted[vertex] = true;
+        for (const HierarchyArc& arc : out[vertex]) {
+            std::vector<HierarchyArc>& list = in[arc.other];
+            list.erase(std::remove_if(list.begin(), list.end(), 
+                [&](const HierarchyArc& other) { return other.other == vertex; }), list.end());
+        }
+        for (const HierarchyArc& arc : in[vertex]) {
+            std::vector<HierarchyArc>& list = out[arc.other];
+            list.erase(std::remove_if(list.begin(), list.end(), 
+                [&](const HierarchyArc& other) { return other.other == vertex; }), list.end());
+        }
+    }
+};
+
+/**
+ * @brief Packs per-vertex lists into offsets and one flat array.
+ */
+void flattenArcs(std::vector<std::vector<HierarchyArc>>& lists, std::vector<uint64_t>& offsets, 
+        std::vector<HierarchyArc>& arcs) {
+    offsets.assign(lists.size() + 1, 0);
+    for (size_t i = 0; i < lists.size(); i++)
+        offsets[i + 1] = offsets[i] + lists[i].size();
+    arcs.clear();
+    arcs.reserve(offsets.back());
+    for (std::vector<HierarchyArc>& list : lists) {
+        arcs.insert(arcs.end(), list.begin(), list.end());
+        std::vector<HierarchyArc>().swap(list);
+    }
+}
+
+ContractionHierarchy::ContractionHierarchy(const CsrGraph& graph) : _vertexCount(graph.vertexCount()) {
+    HierarchyBuilder builder(graph);
+    const uint32_t n = _vertexCount;
+    IndexedHeap<int> queue(n);
+    for (uint32_t vertex = 0; vertex < n; vertex++)
+        queue.insert(vertex, builder.priority(vertex));
+
+    // A contracted vertex's remaining arcs all lead to vertices contracted later: they are its upward arcs.
+    std::vector<std::vector<HierarchyArc>> up(n);
+    std::vector<std::vector<HierarchyArc>> down(n);
+    _ranks.resize(n);
+    uint32_t rank = 0;
+    while (queue.getCount() > 0) {
+        // Lazy update: priorities go stale as the graph changes, so recheck the best one before contracting it.
+        uint32_t vertex = queue.getMin();
+        int current = builder.priority(vertex);
+        if (current > queue.getMinKey()) {
+            queue.updateKey(vertex, current);
+            if (queue.getMin() != vertex)
+                continue;
+        }
+        queue.extractMin();
+
+        builder.contract(vertex, false);
+        builder.detach(vertex);
+        _ranks[vertex] = rank++;
+        up[vertex] = builder.out[vertex];
+        down[vertex] = builder.in[vertex];
+
+        std::vector<uint32_t> neighbours;
+        for (const HierarchyArc& arc : up[vertex])
+            neighbours.push_back(arc.other);
+        for (const HierarchyArc& arc : down[vertex])
+            neighbours.push_back(arc.other);
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (uint32_t neighbour : neighbours) {
+            builder.contractedNeighbours[neighbour]++;
+            builder.depth[neighbour] = std::max(builder.depth[neighbour], builder.depth[vertex] + 1);
+            queue.updateKey(neighbour, builder.priority(neighbour));
+        }
+    }
+
+    flattenArcs(up, _upOffsets, _upArcs);
+    flattenArcs(down, _downOffsets, _downArcs);
+}
+
+const HierarchyArc& ContractionHierarchy::findArc(uint32_t from, uint32_t to) const {
+    if (_ranks[from] < _ranks[to]) {
+        for (uint64_t i = _upOffsets[from]; i < _upOffsets[from + 1]; i++) {
+            if (_upArcs[i].other == to)
+                return _upArcs[i];
+        }
+    } else {
+        for (uint64_t i = _downOffsets[to]; i < _downOffsets[to + 1]; i++) {
+            if (_downArcs[i].other == from)
+                return _downArcs[i];
+        }
+    }
+    throw std::logic_error("Missing hierarchy arc.");
+}
+
+void ContractionHierarchy::unpack(uint32_t from, uint32_t to, std::vector<uint32_t>& path) const {
+    // Shortcuts nest deeply on long roads, so unpack with an explicit stack. The top is always the next piece of the 
+    // path.
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    stack.push_back({from, to});
+    while (!stack.empty()) {
+        std::pair<uint32_t, uint32_t> piece = stack.back();
+        stack.pop_back();
+        uint32_t middle = findArc(piece.first, piece.second).middle;
+        if (middle == CompactGraph::NO_VERTEX) {
+            path.push_back(piece.second);
+        } else {
+            stack.push_back({middle, piece.second});
+            stack.push_back({piece.first, middle});
+        }
+    }
+}
+
+ShortestPath ContractionHierarchy::query(uint32_t origin, uint32_t target, PathWorkspace& workspace, 
+        bool unpackPath) const {
+    PathWorkspace::Side& forward = workspace._forward;
+    PathWorkspace::Side& backward = workspace._backward;
+    PathWorkspace::reset(forward, _vertexCount);
+    PathWorkspace::reset(backward, _vertexCount);
+    PathWorkspace::Side* sides[2] = {&forward, &backward};
+    const std::vector<uint64_t>* offsets[2] = {&_upOffsets, &_downOffsets};
+    const std::vector<HierarchyArc>* arcs[2] = {&_upArcs, &_downArcs};
+    for (int s = 0; s < 2; s++) {
+        uint32_t start = (s == 0) ? origin : target;
+        sides[s]->costs[start] = 0;
+        sides[s]->predecessors[start] = start;
+        sides[s]->touched.push_back(start);
+        sides[s]->heap.insert(start, 0);
+    }
+
+    // Each side only goes up, so neither can stop at the first meeting: each runs until its next vertex costs more 
+    // than the best path found.
+    int64_t best = INT64_MAX;
+    uint32_t meeting = CompactGraph::NO_VERTEX;
+    ShortestPath path = {INT32_MAX, {}, 0};
+    int s = 0;
+    while (true) {
+        bool forwardOpen = forward.heap.getCount() > 0 && forward.heap.getMinKey() < best;
+        bool backwardOpen = backward.heap.getCount() > 0 && backward.heap.getMinKey() < best;
+        if (!forwardOpen && !backwardOpen)
+            break;
+        s = (forwardOpen && backwardOpen) ? 1 - s : (forwardOpen ? 0 : 1);
+
+        PathWorkspace::Side& side = *sides[s];
+        PathWorkspace::Side& other = *sides[1 - s];
+        uint32_t vertex = side.heap.extractMin();
+        side.settled[vertex] = true;
+        path.settledCount++;
+        int cost = side.costs[vertex];
+        if (other.costs[vertex] != INT32_MAX && int64_t(cost) + other.costs[vertex] < best) {
+            best = int64_t(cost) + other.costs[vertex];
+            meeting = vertex;
+        }
+
+        for (uint64_t i = (*offsets[s])[vertex]; i < (*offsets[s])[vertex + 1]; i++) {
+            const HierarchyArc& arc = (*arcs[s])[i];
+            int64_t newCost = int64_t(cost) + arc.weight;
+            if (newCost >= side.costs[arc.other])
+                continue;
+            if (side.costs[arc.other] == INT32_MAX)
+                side.touched.push_back(arc.other);
+            side.costs[arc.other] = newCost;
+            side.predecessors[arc.other] = vertex;
+            side.heap.insertOrDecrease(arc.other, newCost);
+        }
+    }
+
+    if (meeting == CompactGraph::NO_VERTEX || best >= INT32_MAX)
+        return path;
+    path.cost = best;
+    if (!unpackPath)
+        return path;
+
+    // Hierarchy vertices from origin up to the meeting vertex and back down to target, then every edge unpacked.
+    std::vector<uint32_t> hierarchyPath;
+    for (uint32_t vertex = meeting; vertex != origin; vertex = forward.predecessors[vertex])
+        hierarchyPath.push_back(vertex);
+    hierarchyPath.push_back(origin);
+    std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+    for (uint32_t vertex = meeting; vertex != target; ) {
+        vertex = backward.predecessors[vertex];
+        hierarchyPath.push_back(vertex);
+    }
+
+    path.vertices.push_back(origin);
+    for (size_t i = 0; i + 1 < hierarchyPath.size(); i++)
+        unpack(hierarchyPath[i], hierarchyPath[i + 1], path.vertices);
+    return path;
+}
+
+template <typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& values) {
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+void readArray(std::ifstream& file, std::vector<T>& values, uint64_t count) {
+    values.resize(count);
+    file.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+}
+
+/**
+ * @brief Returns whether loaded ranks are a permutation of 0, 1, ..., n - 1, so that every vertex has its own rank.
+ */
+bool validRanks(const std::vector<uint32_t>& ranks) {
+    std::vector<bool> taken(ranks.size(), false);
+    for (uint32_t rank : ranks) {
+        if (rank >= ranks.size() || taken[rank])
+            return false;
+        taken[rank] = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether a loaded offset and arc array describe arcs between existing vertices that lead up in rank 
+ * (from the vertex to other for up arcs, from other to the vertex for down arcs), and whose middle vertex, if any, 
+ * ranks below both ends. That is what query() and unpack() rely on to stay in bounds and to terminate.
+ */
+bool validArcs(const std::vector<uint64_t>& offsets, const std::vector<HierarchyArc>& arcs, 
+        const std::vector<uint32_t>& ranks) {
+    // Every offset must be in order and in bounds before any arc is read through them.
+    const uint32_t n = ranks.size();
+    if (offsets[0] != 0 || offsets[n] != arcs.size())
+        return false;
+    for (uint32_t vertex = 0; vertex < n; vertex++) {
+        if (offsets[vertex] > offsets[vertex + 1])
+            return false;
+    }
+
+    for (uint32_t vertex = 0; vertex < n; vertex++) {
+        for (uint64_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+            const HierarchyArc& arc = arcs[i];
+            if (arc.other >= n || ranks[arc.other] <= ranks[vertex] || arc.weight < 0)
+                return false;
+            if (arc.middle != CompactGraph::NO_VERTEX && (arc.middle >= n || ranks[arc.middle] >= ranks[vertex]))
+                return false;
+        }
+    }
+    return true;
+}
+
+void ContractionHierarchy::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+
+    uint64_t upCount = _upArcs.size();
+    uint64_t downCount = _downArcs.size();
+    file.write(HIERARCHY_FILE_MAGIC, sizeof(HIERARCHY_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&HIERARCHY_FILE_VERSION), sizeof(HIERARCHY_FILE_VERSION));
+    file.write(reinterpret_cast<const char*>(&_vertexCount), sizeof(_vertexCount));
+    file.write(reinterpret_cast<const char*>(&upCount), sizeof(upCount));
+    file.write(reinterpret_cast<const char*>(&downCount), sizeof(downCount));
+    writeArray(file, _ranks);
+    writeArray(file, _upOffsets);
+    writeArray(file, _upArcs);
+    writeArray(file, _downOffsets);
+    writeArray(file, _downArcs);
+    if (!file)
+        throw std::runtime_error("Could not write " + path + ".");
+}
+
+ContractionHierarchy ContractionHierarchy::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for reading.");
+
+    char magic[sizeof(HIERARCHY_FILE_MAGIC)];
+    uint32_t version = 0;
+    uint64_t upCount = 0;
+    uint64_t downCount = 0;
+    ContractionHierarchy hierarchy;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&hierarchy._vertexCount), sizeof(hierarchy._vertexCount));
+    file.read(reinterpret_cast<char*>(&upCount), sizeof(upCount));
+    file.read(reinterpret_cast<char*>(&downCount), sizeof(downCount));
+    if (!file || std::memcmp(magic, HIERARCHY_FILE_MAGIC, sizeof(magic)) != 0 || version != HIERARCHY_FILE_VERSION)
+        throw std::runtime_error(path + " is not a supported contraction hierarchy file.");
+
+    // Check the counts against the file size before allocating anything for them.
+    const uint32_t n = hierarchy._vertexCount;
+    const uint64_t headerEnd = file.tellg();
+    file.seekg(0, std::ios::end);
+    const uint64_t length = file.tellg();
+    file.seekg(headerEnd);
+    const uint64_t arcLimit = (length - headerEnd) / sizeof(HierarchyArc);
+    if (!file || upCount > arcLimit || downCount > arcLimit 
+            || headerEnd + n * sizeof(uint32_t) + 2 * (uint64_t(n) + 1) * sizeof(uint64_t) 
+                    + (upCount + downCount) * sizeof(HierarchyArc) != length)
+        throw std::runtime_error(path + " is truncated or corrupt.");
+
+    readArray(file, hierarchy._ranks, n);
+    readArray(file, hierarchy._upOffsets, uint64_t(n) + 1);
+    readArray(file, hierarchy._upArcs, upCount);
+    readArray(file, hierarchy._downOffsets, uint64_t(n) + 1);
+    readArray(file, hierarchy._downArcs, downCount);
+    if (!file || !validRanks(hierarchy._ranks) || !validArcs(hierarchy._upOffsets, hierarchy._upArcs, hierarchy._ranks) 
+            || !validArcs(hierarchy._downOffsets, hierarchy._downArcs, hierarchy._ranks))
+        throw std::runtime_error(path + " is truncated or corrupt.");
+    return hierarchy;
+}
+
+uint32_t ContractionHierarchy::vertexCount() const {
+    return _vertexCount;
+}
+
+uint32_t ContractionHierarchy::getRank(uint32_t vertex) const {
+    return _ranks[vertex];
+}
+
+uint64_t ContractionHierarchy::arcCount() const {
+    return _upArcs.size() + _downArcs.size();
+}
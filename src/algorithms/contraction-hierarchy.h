@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "csr-graph.h"
+#include "point-to-point.h"
+
+/**
+ * @brief An edge of a contraction hierarchy. other is the far end; middle is the vertex a shortcut bypasses, or 
+ * CompactGraph::NO_VERTEX for an edge of the original graph.
+ */
+struct HierarchyArc {
+    uint32_t other;
+    int32_t weight;
+    uint32_t middle;
+};
+
+/**
+ * @brief A contraction hierarchy for fast shortest path queries on a graph that does not change, such as a road 
+ * network.
+ * 
+ * Preprocessing contracts the vertices one by one, least important first. Contracting a vertex removes it and adds a 
+ * shortcut between each pair of its neighbours whose shortest path ran through it, unless a short enough witness path 
+ * around it exists. Importance is estimated from how many shortcuts a contraction would add compared to the edges it 
+ * removes, how many neighbours are already contracted and how deep the hierarchy under a vertex is; estimates are 
+ * refreshed for a vertex's neighbours after it is contracted and for the next candidate before it is.
+ * 
+ * Every edge then leads up or down in the order of contraction. A query searches only upwards from both ends, which 
+ * explores a few hundred vertices even on very large road networks, and unpacks the shortcuts on the path it finds 
+ * back into original edges.
+ */
+class ContractionHierarchy {
+private:
+    uint32_t _vertexCount;
+    std::vector<uint32_t> _ranks;        // Order of contraction: lower ranks were contracted first.
+    std::vector<uint64_t> _upOffsets;
+    std::vector<HierarchyArc> _upArcs;   // Edges from each vertex to higher ranked ones.
+    std::vector<uint64_t> _downOffsets;
+    std::vector<HierarchyArc> _downArcs; // Edges into each vertex from higher ranked ones; other is the source.
+
+    ContractionHierarchy() = default;
+
+    /**
+     * @brief Returns the hierarchy edge from a to b, which is stored at whichever end has the lower rank.
+     */
+    const HierarchyArc& findArc(uint32_t from, uint32_t to) const;
+
+    /**
+     * @brief Appends the original vertices along a hierarchy edge, excluding from and including to.
+     */
+    void unpack(uint32_t from, uint32_t to, std::vector<uint32_t>& path) const;
+
+public:
+    /**
+     * @brief Preprocesses a graph. Weights must not be negative. Undirected graphs are treated as having an edge 
+     * each way.
+     * 
+     * @param graph the graph to build a hierarchy for
+     */
+    explicit ContractionHierarchy(const CsrGraph& graph);
+
+    /**
+     * @brief Reads a hierarchy written by save(). Throws std::runtime_error if the file cannot be read or is not a 
+     * hierarchy.
+     * 
+     * @param path file to read
+     * @return ContractionHierarchy the hierarchy
+     */
+    static ContractionHierarchy load(const std::string& path);
+
+    /**
+     * @brief Writes the hierarchy to a file. Throws std::runtime_error if the file cannot be written.
+     * 
+     * @param path file to write
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Finds the shortest path between two vertices with an upward search from each end. Paths costing INT32_MAX 
+     * or more are reported as unreachable, with a cost of INT32_MAX.
+     * 
+     * @param origin id of the vertex to start from
+     * @param target id of the vertex to reach
+     * @param workspace memory kept between queries
+     * @param unpackPath whether to fill in the path's vertices; the cost alone is cheaper
+     * @return ShortestPath the path in original vertices and its cost
+     */
+    ShortestPath query(uint32_t origin, uint32_t target, PathWorkspace& workspace, bool unpackPath = true) const;
+
+    uint32_t vertexCount() const;
+    uint32_t getRank(uint32_t vertex) const;
+
+    /**
+     * @brief Returns how many edges the hierarchy has, shortcuts included.
+     */
+    uint64_t arcCount() const;
+};
@@ -0,0 +1,258 @@
+#include "delta-stepping.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <stdexcept>
+#include "parallel.h"
+
+/*
+ * Each vertex's cost and predecessor are packed into one 64 bit word, cost in the high half, so both change together 
+ * in one compare-and-swap.
+*/
+
+constexpr uint64_t UNREACHED = (uint64_t(INT32_MAX) << 32) | CompactGraph::NO_VERTEX;
+
+inline uint64_t packPath(uint32_t cost, uint32_t predecessor) {
+    return (uint64_t(cost) << 32) | predecessor;
+}
+
+/*
+ * Every cost filed while bucket b is current is below (b + 1) * delta + the heaviest weight, so the live buckets span 
+ * at most maxWeight / delta + 2 indices and can share a cyclic array. That span is capped so that a tiny delta or a 
+ * huge weight cannot blow up memory; buckets beyond the cap are kept sparsely until the current bucket comes close.
+*/
+
+constexpr size_t MAX_RING_BUCKETS = 1 << 16;
+
+/**
+ * @brief One thread's buckets.
+ */
+struct DeltaSteppingBins {
+    std::vector<std::vector<uint32_t>> ring;     // Bucket b is ring[b % ringSize], for b less than ringSize ahead.
+    std::map<size_t, std::vector<uint32_t>> far; // Buckets further ahead, by index.
+};
+
+/**
+ * @brief The state shared by the threads of one search.
+ */
+struct DeltaSteppingState {
+    std::vector<std::atomic<uint64_t>> paths;
+    std::vector<DeltaSteppingBins> bins;        // Per thread.
+    std::vector<std::vector<uint32_t>> settled; // Per thread: vertices processed in the current bucket.
+    std::vector<uint32_t> frontier;
+    std::atomic<size_t> cursor;
+    size_t ringSize;
+    size_t bucket;
+    bool done;
+    Barrier barrier;
+
+    DeltaSteppingState(uint32_t vertexCount, unsigned int threadCount, size_t ringSize) : paths(vertexCount), 
+            bins(threadCount), settled(threadCount), cursor(0), ringSize(ringSize), bucket(0), done(false), 
+            barrier(threadCount) {
+        for (std::atomic<uint64_t>& path : paths)
+            path.store(UNREACHED, std::memory_order_relaxed);
+        for (DeltaSteppingBins& threadBins : bins)
+            threadBins.ring.resize(ringSize);
+    }
+};
+
+/**
+ * @brief Returns the heaviest edge weight, checking that none is negative.
+ */
+template <typename G>
+int32_t maxWeight_t(const G& graph) {
+    int32_t maxWeight = 0;
+    for (uint32_t i = 0; i < graph.vertexCount(); i++) {
+        for (CompactEdge edge : graph.getEdges(i)) {
+            if (edge.weight < 0)
+                throw std::invalid_argument("Delta-stepping needs non-negative weights.");
+            maxWeight = std::max(maxWeight, edge.weight);
+        }
+    }
+    return maxWeight;
+}
+
+template <typename G>
+int32_t chooseDelta_t(const G& graph) {
+    size_t adjacencies = 0;
+    for (uint32_t i = 0; i < graph.vertexCount(); i++)
+        adjacencies += graph.getEdges(i).size();
+    if (adjacencies == 0)
+        return 1;
+
+    // Sample about 4096 weights, checking every weight for the sign on the way.
+    const size_t step = std::max<size_t>(1, adjacencies / 4096);
+    std::vector<int32_t> sample;
+    size_t index = 0;
+    int32_t maxWeight = 0;
+    for (uint32_t i = 0; i < graph.vertexCount(); i++) {
+        for (CompactEdge edge : graph.getEdges(i)) {
+            if (edge.weight < 0)
+                throw std::invalid_argument("Delta-stepping needs non-negative weights.");
+            maxWeight = std::max(maxWeight, edge.weight);
+            if (index++ % step == 0)
+                sample.push_back(edge.weight);
+        }
+    }
+
+    std::vector<int32_t>::iterator percentile = sample.begin() + sample.size() * 9 / 10;
+    std::nth_element(sample.begin(), percentile, sample.end());
+    double averageDegree = double(adjacencies) / graph.vertexCount();
+    int32_t delta = std::max<int32_t>(1, int32_t(*percentile / std::max(1.0, averageDegree)));
+
+    // Wide enough that every live bucket fits in the ring.
+    int32_t ringDelta = int32_t((maxWeight + (MAX_RING_BUCKETS - 3)) / (MAX_RING_BUCKETS - 2));
+    return std::max(delta, ringDelta);
+}
+
+/**
+ * @brief Relaxes the light (weight at most delta) or heavy edges of a vertex, filing every improved vertex in this 
+ * thread's bin for its new bucket.
+ */
+template <typename G>
+void relaxEdges(const G& graph, DeltaSteppingState& state, uint32_t vertex, uint32_t cost, int32_t delta, bool light, 
+        DeltaSteppingBins& bins) {
+    for (CompactEdge edge : graph.getEdges(vertex)) {
+        if ((edge.weight <= delta) != light)
+            continue;
+        uint64_t newCost = uint64_t(cost) + edge.weight;
+        std::atomic<uint64_t>& path = state.paths[edge.target];
+        uint64_t current = path.load(std::memory_order_relaxed);
+        while (newCost < (current >> 32)) {
+            if (path.compare_exchange_weak(current, packPath(newCost, vertex), std::memory_order_relaxed)) {
+                size_t bucket = newCost / delta;
+                if (bucket < state.bucket + state.ringSize)
+                    bins.ring[bucket % state.ringSize].push_back(edge.target);
+                else
+                    bins.far[bucket].push_back(edge.target);
+                break;
+            }
+        }
+    }
+}
+
+template <typename G>
+void deltaSteppingThread(const G& graph, DeltaSteppingState& state, int32_t delta, unsigned int threadIndex) {
+    DeltaSteppingBins& bins = state.bins[threadIndex];
+    std::vector<uint32_t>& settled = state.settled[threadIndex];
+    const size_t chunk = 64;
+
+    while (true) {
+        // Thread 0 gathers the current bucket from every thread's bins.
+        if (threadIndex == 0) {
+            state.frontier.clear();
+            for (DeltaSteppingBins& threadBins : state.bins) {
+                std::vector<uint32_t>& bin = threadBins.ring[state.bucket % state.ringSize];
+                state.frontier.insert(state.frontier.end(), bin.begin(), bin.end());
+                bin.clear();
+            }
+            state.cursor.store(0, std::memory_order_relaxed);
+        }
+        state.barrier.wait();
+
+        if (!state.frontier.empty()) {
+            // Light edges, taking chunks of the frontier until it runs out. Relaxations may refill the bucket, in 
+            // which case the next round picks it up again. A vertex filed more than once is only processed for its 
+            // current cost, and only while that cost is still in this bucket.
+            size_t begin;
+            while ((begin = state.cursor.fetch_add(chunk, std::memory_order_relaxed)) < state.frontier.size()) {
+                size_t end = std::min(begin + chunk, state.frontier.size());
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t vertex = state.frontier[i];
+                    uint32_t cost = state.paths[vertex].load(std::memory_order_relaxed) >> 32;
+                    if (cost / delta != state.bucket)
+                        continue;
+                    relaxEdges(graph, state, vertex, cost, delta, true, bins);
+                    settled.push_back(vertex);
+                }
+            }
+            state.barrier.wait();
+            continue;
+        }
+
+        // The bucket stays empty, so its vertices are final: relax their heavy edges, which land in later buckets.
+        for (uint32_t vertex : settled) {
+            uint32_t cost = state.paths[vertex].load(std::memory_order_relaxed) >> 32;
+            relaxEdges(graph, state, vertex, cost, delta, false, bins);
+        }
+        settled.clear();
+        state.barrier.wait();
+
+        // Thread 0 moves on to the lowest bucket any thread has filled. Far buckets all lie beyond the ring, so they 
+        // only count once the ring is empty. Then the far buckets the ring now reaches are moved into it.
+        if (threadIndex == 0) {
+            size_t next = SIZE_MAX;
+            for (size_t b = state.bucket + 1; b < state.bucket + state.ringSize && next == SIZE_MAX; b++) {
+                for (DeltaSteppingBins& threadBins : state.bins) {
+                    if (!threadBins.ring[b % state.ringSize].empty()) {
+                        next = b;
+                        break;
+                    }
+                }
+            }
+            if (next == SIZE_MAX) {
+                for (DeltaSteppingBins& threadBins : state.bins) {
+                    if (!threadBins.far.empty())
+                        next = std::min(next, threadBins.far.begin()->first);
+                }
+            }
+            state.done = (next == SIZE_MAX);
+            state.bucket = next;
+            for (DeltaSteppingBins& threadBins : state.bins) {
+                while (!state.done && !threadBins.far.empty() 
+                        && threadBins.far.begin()->first < state.bucket + state.ringSize) {
+                    std::map<size_t, std::vector<uint32_t>>::iterator first = threadBins.far.begin();
+                    threadBins.ring[first->first % state.ringSize].swap(first->second);
+                    threadBins.far.erase(first);
+                }
+            }
+        }
+        state.barrier.wait();
+        if (state.done)
+            break;
+    }
+}
+
+template <typename G>
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath_t(const G& graph, uint32_t origin, unsigned int threadCount, 
+        int32_t delta) {
+    const uint32_t n = graph.vertexCount();
+    const int32_t maxWeight = maxWeight_t(graph);
+    if (delta <= 0)
+        delta = chooseDelta_t(graph);
+    threadCount = resolveThreadCount(threadCount);
+
+    DeltaSteppingState state(n, threadCount, std::min<size_t>(size_t(maxWeight / delta) + 2, MAX_RING_BUCKETS));
+    state.paths[origin].store(packPath(0, origin), std::memory_order_relaxed);
+    state.bins[0].ring[0].push_back(origin);
+
+    parallelRegion(threadCount, [&](unsigned int threadIndex) {
+        deltaSteppingThread(graph, state, delta, threadIndex);
+    });
+
+    std::vector<DenseDijkstraInfo> dijkstraTable(n);
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t path = state.paths[i].load(std::memory_order_relaxed);
+        dijkstraTable[i] = {path != UNREACHED, uint32_t(path), int(path >> 32)};
+    }
+    return dijkstraTable;
+}
+
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CompactGraph& graph, uint32_t origin, 
+        unsigned int threadCount, int32_t delta) {
+    return deltaSteppingShortestPath_t(graph, origin, threadCount, delta);
+}
+
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CsrGraph& graph, uint32_t origin, 
+        unsigned int threadCount, int32_t delta) {
+    return deltaSteppingShortestPath_t(graph, origin, threadCount, delta);
+}
+
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CompressedGraph& graph, uint32_t origin, 
+        unsigned int threadCount, int32_t delta) {
+    return deltaSteppingShortestPath_t(graph, origin, threadCount, delta);
+}
+
+int32_t chooseDelta(const CsrGraph& graph) {
+    return chooseDelta_t(graph);
+}
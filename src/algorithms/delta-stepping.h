@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+#include "graph-algorithms.h"
+
+/*
+ * Delta-stepping (Meyer and Sanders) spreads single source shortest paths over several threads. Tentative distances 
+ * are sorted into buckets of width delta instead of being kept in a heap. All vertices in the lowest bucket are 
+ * processed at the same time: their light edges (weight at most delta) are relaxed over and over until the bucket 
+ * stays empty, then their heavy edges are relaxed once, since those can only reach later buckets. Distances are 
+ * lowered with an atomic compare-and-swap, so threads never lock each other out.
+ * 
+ * A small delta does little wasted work but has many buckets to step through; a large one has few buckets but 
+ * relaxes edges more than once. Weights must not be negative.
+ * 
+ * Buckets live in a cyclic array covering the heaviest weight, capped at 65536 buckets per thread; buckets beyond the 
+ * cap are kept in a sparse map, so memory does not grow with the largest path cost.
+*/
+
+/**
+ * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex, computed with 
+ * delta-stepping. Same table as singleSourceShortestPath, although among equally short paths a different predecessor 
+ * may be picked.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @param delta bucket width; 0 picks one from the weights
+ * @return std::vector<DenseDijkstraInfo> a table of shortest paths info
+ */
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CompactGraph& graph, uint32_t origin, 
+        unsigned int threadCount = 0, int32_t delta = 0);
+
+/**
+ * @brief See deltaSteppingShortestPath(const CompactGraph&, ...).
+ */
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CsrGraph& graph, uint32_t origin, 
+        unsigned int threadCount = 0, int32_t delta = 0);
+
+/**
+ * @brief See deltaSteppingShortestPath(const CompactGraph&, ...). Adjacency lists are decoded on the fly.
+ */
+std::vector<DenseDijkstraInfo> deltaSteppingShortestPath(const CompressedGraph& graph, uint32_t origin, 
+        unsigned int threadCount = 0, int32_t delta = 0);
+
+/**
+ * @brief Picks a bucket width for delta-stepping: a high percentile of the edge weights divided by the average 
+ * degree, which is the width Meyer and Sanders suggest, with outlying heavy edges ignored. It is widened if needed so 
+ * that the heaviest edge spans at most 65534 buckets, which keeps every live bucket in the cyclic array.
+ * 
+ * @param graph the graph the search will run on
+ * @return int32_t the bucket width, at least 1
+ */
+int32_t chooseDelta(const CsrGraph& graph);
@@ -0,0 +1,175 @@
+#include "dynamic-shortest-paths.h"
+#include <stdexcept>
+
+DynamicShortestPaths::DynamicShortestPaths(CompactGraph& graph, uint32_t origin) : _graph(graph) {
+    _origin = origin;
+    _table = singleSourceShortestPath(graph, origin);
+    _affected.assign(_table.size(), false);
+}
+
+const std::vector<DenseDijkstraInfo>& DynamicShortestPaths::getTable() const {
+    return _table;
+}
+
+uint32_t DynamicShortestPaths::getOrigin() const {
+    return _origin;
+}
+
+const CompactGraph& DynamicShortestPaths::getGraph() const {
+    return _graph;
+}
+
+void DynamicShortestPaths::growTable() {
+    _table.resize(_graph.vertexCount(), {false, CompactGraph::NO_VERTEX, INT32_MAX});
+    _affected.resize(_graph.vertexCount(), false);
+}
+
+int32_t DynamicShortestPaths::edgeWeight(uint32_t vertexA, uint32_t vertexB) const {
+    for (CompactEdge edge : _graph.getEdges(vertexA)) {
+        if (edge.target == vertexB)
+            return edge.weight;
+    }
+    return INT32_MAX;
+}
+
+void DynamicShortestPaths::repairDecrease(uint32_t from, uint32_t to, int32_t weight) {
+    // Costs are summed in int64; a path costing INT32_MAX or more stays unreached.
+    if (_table[from].cost == INT32_MAX || int64_t(_table[from].cost) + weight >= _table[to].cost)
+        return;
+
+    _distanceHeap.clear();
+    _table[to] = {true, from, int(_table[from].cost + weight)};
+    _distanceHeap.push({_table[to].cost, to});
+
+    // Dijkstra's algorithm, but only through vertices whose cost just improved.
+    while (_distanceHeap.getCount() > 0) {
+        DistanceEntry entry = _distanceHeap.extractTop();
+        if (entry.cost > _table[entry.vertex].cost)
+            continue;
+        for (CompactEdge edge : _graph.getEdges(entry.vertex)) {
+            int64_t newCost = int64_t(entry.cost) + edge.weight;
+            if (newCost < _table[edge.target].cost) {
+                _table[edge.target] = {true, entry.vertex, int(newCost)};
+                _distanceHeap.push({int(newCost), edge.target});
+            }
+        }
+    }
+}
+
+bool DynamicShortestPaths::isTreeEdge(uint32_t from, uint32_t to, int32_t weight) const {
+    return to != _origin && _table[to].predecessor == from && _table[from].cost != INT32_MAX 
+            && int64_t(_table[from].cost) + weight == _table[to].cost;
+}
+
+void DynamicShortestPaths::repairIncrease(const std::vector<uint32_t>& roots) {
+    // The affected vertices are the roots and everything below them in the tree. Tree edges are graph edges, so the 
+    // subtree is found by following out-edges to vertices whose predecessor is already affected.
+    std::vector<uint32_t> affected;
+    for (uint32_t root : roots) {
+        if (root != _origin && !_affected[root]) {
+            _affected[root] = true;
+            affected.push_back(root);
+        }
+    }
+    for (int i = 0; i < affected.size(); i++) {
+        for (CompactEdge edge : _graph.getEdges(affected[i])) {
+            uint32_t child = edge.target;
+            if (!_affected[child] && child != _origin && _table[child].predecessor == affected[i]) {
+                _affected[child] = true;
+                affected.push_back(child);
+            }
+        }
+    }
+
+    // Forget the old costs, then seed each affected vertex with its best edge from an unaffected in-neighbour.
+    for (uint32_t vertex : affected)
+        _table[vertex] = {false, CompactGraph::NO_VERTEX, INT32_MAX};
+    _distanceHeap.clear();
+    for (uint32_t vertex : affected) {
+        for (CompactEdge edge : _graph.getInEdges(vertex)) {
+            const DenseDijkstraInfo& source = _table[edge.target];
+            int64_t cost = int64_t(source.cost) + edge.weight;
+            if (!_affected[edge.target] && source.cost != INT32_MAX && cost < _table[vertex].cost)
+                _table[vertex] = {true, edge.target, int(cost)};
+        }
+        if (_table[vertex].cost != INT32_MAX)
+            _distanceHeap.push({_table[vertex].cost, vertex});
+    }
+
+    // Settle the subtree. Costs outside it cannot have changed, so only affected vertices are relaxed.
+    while (_distanceHeap.getCount() > 0) {
+        DistanceEntry entry = _distanceHeap.extractTop();
+        if (entry.cost > _table[entry.vertex].cost)
+            continue;
+        for (CompactEdge edge : _graph.getEdges(entry.vertex)) {
+            int64_t newCost = int64_t(entry.cost) + edge.weight;
+            if (_affected[edge.target] && newCost < _table[edge.target].cost) {
+                _table[edge.target] = {true, entry.vertex, int(newCost)};
+                _distanceHeap.push({int(newCost), edge.target});
+            }
+        }
+    }
+
+    for (uint32_t vertex : affected)
+        _affected[vertex] = false;
+}
+
+void DynamicShortestPaths::repairChange(uint32_t vertexA, uint32_t vertexB, int32_t oldWeight, int32_t newWeight, 
+        bool removed) {
+    const bool undirected = _graph.getType() == GraphType::undirected;
+    if (!removed && newWeight < oldWeight) {
+        repairDecrease(vertexA, vertexB, newWeight);
+        if (undirected)
+            repairDecrease(vertexB, vertexA, newWeight);
+    } else if (removed || newWeight > oldWeight) {
+        std::vector<uint32_t> roots;
+        if (isTreeEdge(vertexA, vertexB, oldWeight))
+            roots.push_back(vertexB);
+        if (undirected && isTreeEdge(vertexB, vertexA, oldWeight))
+            roots.push_back(vertexA);
+        if (!roots.empty())
+            repairIncrease(roots);
+    }
+}
+
+uint32_t DynamicShortestPaths::addVertex(std::string_view tag) {
+    uint32_t vertex = _graph.addVertex(tag);
+    growTable();
+    return vertex;
+}
+
+void DynamicShortestPaths::addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    _graph.addEdge(vertexA, vertexB, weight);
+    repairChange(vertexA, vertexB, INT32_MAX, weight, false);
+}
+
+bool DynamicShortestPaths::removeEdge(uint32_t vertexA, uint32_t vertexB) {
+    int32_t oldWeight = edgeWeight(vertexA, vertexB);
+    if (!_graph.removeEdge(vertexA, vertexB))
+        return false;
+    repairChange(vertexA, vertexB, oldWeight, INT32_MAX, true);
+    return true;
+}
+
+bool DynamicShortestPaths::updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    int32_t oldWeight = edgeWeight(vertexA, vertexB);
+    if (!_graph.updateWeight(vertexA, vertexB, weight))
+        return false;
+    repairChange(vertexA, vertexB, oldWeight, weight, false);
+    return true;
+}
+
+void DynamicShortestPaths::removeVertex(uint32_t vertex) {
+    if (vertex == _origin)
+        throw std::invalid_argument("Cannot remove the origin.");
+
+    // Every vertex hanging directly below the removed one loses its tree edge.
+    std::vector<uint32_t> roots;
+    for (CompactEdge edge : _graph.getEdges(vertex)) {
+        if (edge.target != _origin && _table[edge.target].predecessor == vertex)
+            roots.push_back(edge.target);
+    }
+    _graph.removeVertex(vertex);
+    _table[vertex] = {false, CompactGraph::NO_VERTEX, INT32_MAX};
+    repairIncrease(roots);
+}
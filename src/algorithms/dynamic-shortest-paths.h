@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "compact-graph.h"
+#include "graph-algorithms.h"
+
+/**
+ * @brief Keeps a single source shortest paths table up to date while its graph changes, without recomputing it from 
+ * scratch. Changes must go through this object so it knows what to repair.
+ * 
+ * Repairs follow Ramalingam and Reps:
+ *     - When an edge is added or gets lighter, only vertices whose cost improves are touched. They are found by 
+ *       running Dijkstra's algorithm outwards from the far end of the edge.
+ *     - When an edge is removed or gets heavier, nothing happens unless it was an edge of the shortest paths tree. If 
+ *       it was, only the subtree hanging below it is recomputed: those vertices are seeded with their best cost from 
+ *       unaffected in-neighbours and then settled with Dijkstra's algorithm inside the subtree.
+ * 
+ * Weights must be non-negative. In the table, visited means the vertex is currently reachable.
+ */
+class DynamicShortestPaths {
+private:
+    CompactGraph& _graph;
+    uint32_t _origin;
+    std::vector<DenseDijkstraInfo> _table;
+    std::vector<bool> _affected;
+    PriorityQueue<DistanceEntry> _distanceHeap; // Kept between repairs so they do not allocate.
+
+    /**
+     * @brief Grows the table (and scratch space) to cover vertices added since the last call.
+     */
+    void growTable();
+
+    /**
+     * @brief Returns the weight of the first edge from vertexA to vertexB, the one CompactGraph would modify.
+     */
+    int32_t edgeWeight(uint32_t vertexA, uint32_t vertexB) const;
+
+    /**
+     * @brief Repairs the table after the edge from one vertex to another got lighter or was added.
+     */
+    void repairDecrease(uint32_t from, uint32_t to, int32_t weight);
+
+    /**
+     * @brief Returns whether the edge from one vertex to another, with the given weight, is the tree edge into to.
+     */
+    bool isTreeEdge(uint32_t from, uint32_t to, int32_t weight) const;
+
+    /**
+     * @brief Recomputes the subtrees below vertices whose tree edge was removed or got heavier.
+     */
+    void repairIncrease(const std::vector<uint32_t>& roots);
+
+    /**
+     * @brief Repairs the table after the edge between two vertices changed from one weight to another (or was removed, 
+     * which is an increase to infinity).
+     */
+    void repairChange(uint32_t vertexA, uint32_t vertexB, int32_t oldWeight, int32_t newWeight, bool removed);
+
+public:
+    /**
+     * @brief Computes the initial shortest paths table.
+     * 
+     * @param graph the graph, which must outlive this object and only be changed through it
+     * @param origin id of the vertex to start from
+     */
+    DynamicShortestPaths(CompactGraph& graph, uint32_t origin);
+
+    ~DynamicShortestPaths() = default;
+
+    /**
+     * @brief Returns the current table, indexed by vertex id.
+     * 
+     * @return const std::vector<DenseDijkstraInfo>& the shortest paths table
+     */
+    const std::vector<DenseDijkstraInfo>& getTable() const;
+
+    uint32_t getOrigin() const;
+    const CompactGraph& getGraph() const;
+
+    /**
+     * @brief Adds a vertex to the graph. A new vertex is unreachable until an edge leads to it.
+     * 
+     * @param tag the vertex's tag
+     * @return uint32_t the vertex's id
+     */
+    uint32_t addVertex(std::string_view tag);
+
+    /**
+     * @brief Adds an edge to the graph and repairs the table.
+     */
+    void addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+
+    /**
+     * @brief Removes one edge from the graph and repairs the table.
+     * 
+     * @return bool true if there was such an edge
+     */
+    bool removeEdge(uint32_t vertexA, uint32_t vertexB);
+
+    /**
+     * @brief Changes the weight of one edge and repairs the table.
+     * 
+     * @return bool true if there was such an edge
+     */
+    bool updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+
+    /**
+     * @brief Removes a vertex and its edges from the graph and repairs the table. The origin cannot be removed.
+     * 
+     * @param vertex the vertex's id
+     */
+    void removeVertex(uint32_t vertex);
+};
@@ -1,18 +1,21 @@
 #include "graph-algorithms.h"
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
 Graph* minimumSpanningTree(const Graph& graph) {
     Graph* result = new Graph();
     int countEdges = 0;
     for (int i = 0; i < graph.getEdges().size(); i++)
         countEdges += graph.getEdges()[i].size();
-    Edge edges[countEdges];
 
     // Prim's algorithm.
-    Heap<Edge> edgeHeap(edges, 0, countEdges, HeapType::min);
+    PriorityQueue<Edge> edgeHeap;
+    edgeHeap.reserve(countEdges);
     for (int i = 0; i < graph.getVertices().size(); i++) {
         // Insert all edges from the current vertex into a min heap.
         for (int j = 0; j < graph.getEdges()[i].size(); j++)
-            edgeHeap.insert(graph.getEdges()[i][j]);
+            edgeHeap.push(graph.getEdges()[i][j]);
         
         // Build result by repeatedly finding the next smallest valid edge from the min heap.
         bool foundValidEdge = false;
@@ -23,7 +26,7 @@ Graph* minimumSpanningTree(const Graph& graph) {
 
             // Extract minimum edge. If one of the vertices in the edge is not in result, then add this edge and that 
             // vertex to result. If both vertices are already in result then don't do anything.
-            Edge edge = edgeHeap.extractMinMax();
+            Edge edge = edgeHeap.extractTop();
             bool validVertexA = true;
             bool validVertexB = true;
             for (int j = 0; j < result->getVertices().size(); j++) {
@@ -46,87 +49,267 @@ Graph* minimumSpanningTree(const Graph& graph) {
     return result;
 }
 
-/*
- * TODO: something tells me the heap is not being used correctly here. I don't think all reachable edges are supposed 
- * to be considered, only the smallest edges until all reachable vertices have been marked as visited. Otherwise, why 
- * use a min heap and not just a queue?
- * 
- * Implementation: https://youtu.be/CerlT7tTZfY
- * 
- * Also, room for improvement: make indexOfVertex O(1) with something like a hash table. Right now it is O(|V|) which 
- * may slow the algorithm down for large graphs.
- * 
- * A good article that takes a slightly different approach: https://www.baeldung.com/cs/dijkstra-time-complexity
-*/
-
 DijkstraInfo* singleSourceShortestPath(const Graph& graph, const Vertex& origin) {
-    // Set up some variables.
-    const Vertex* vertex = &origin;
-    int vertexIndex = graph.indexOfVertex(*vertex);
-
-    DijkstraInfo* dijkstraTable = new DijkstraInfo[graph.getVertices().size()];
-    dijkstraTable[vertexIndex].visited = true;
-    dijkstraTable[vertexIndex].predecessor = &origin;
-    dijkstraTable[vertexIndex].cost = 0;
-    for (int i = 0; i < graph.getVertices().size(); i++) {
-        if (i != vertexIndex) {
-            dijkstraTable[i].visited = false;
-            dijkstraTable[i].predecessor = nullptr;
-            dijkstraTable[i].cost = INT32_MAX;
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    int originIndex = graph.indexOfVertex(origin);
+    if (originIndex == -1)
+        throw std::invalid_argument("Origin is not a vertex of the graph.");
+
+    // Edges refer to vertices by tag. Map each tag to its first index once, as indexOfVertex would, instead of 
+    // scanning the vertices for every edge.
+    std::unordered_map<std::string_view, uint32_t> indices;
+    indices.reserve(vertices.size());
+    for (uint32_t i = 0; i < vertices.size(); i++)
+        indices.emplace(vertices[i].tag, i);
+
+    // Dijkstra on dense ids, then the predecessors are translated back into pointers to the graph's vertices.
+    std::vector<DenseDijkstraInfo> denseTable(vertices.size(), {false, CompactGraph::NO_VERTEX, INT32_MAX});
+    IndexedHeap<int> distanceHeap(vertices.size());
+    denseTable[originIndex] = {false, uint32_t(originIndex), 0};
+    distanceHeap.insert(originIndex, 0);
+    while (distanceHeap.getCount() > 0) {
+        uint32_t vertex = distanceHeap.extractMin();
+        denseTable[vertex].visited = true;
+        for (const Edge& edge : graph.getEdges()[vertex]) {
+            const Vertex& adjacentVertex = (*edge.vertexA == vertices[vertex]) ? *edge.vertexB : *edge.vertexA;
+            // An undirected Graph keeps an edge whose other end was never added as a vertex; it leads nowhere.
+            std::unordered_map<std::string_view, uint32_t>::const_iterator found = indices.find(adjacentVertex.tag);
+            if (found == indices.end())
+                continue;
+            uint32_t adjacentIndex = found->second;
+            DenseDijkstraInfo& adjacent = denseTable[adjacentIndex];
+            int64_t newCost = int64_t(denseTable[vertex].cost) + edge.weight;
+            if (adjacent.visited || newCost >= adjacent.cost)
+                continue;
+            adjacent.predecessor = vertex;
+            adjacent.cost = newCost;
+            distanceHeap.insertOrDecrease(adjacentIndex, newCost);
         }
     }
 
-    Edge edgeHeapSource[graph.edgeCount()];
-    Heap<Edge> edgeHeap(edgeHeapSource, 0, graph.edgeCount(), HeapType::min);
-
-    // Algorithm.
-    bool working = true;
-    while (working) {
-        // Process current unvisited vertex.
-        for (int i = 0; i < graph.getEdges()[vertexIndex].size(); i++) {
-            const Edge& edge = graph.getEdges()[vertexIndex][i];
-            const Vertex& adjacentVertex = (*edge.vertexA == *vertex) ? *edge.vertexB : *edge.vertexA;
-            const int adjacentVertexIndex = graph.indexOfVertex(adjacentVertex);
-            
-            // If the adjacent vertex has not been visited yet, then add the edge going to that vertex to the heap.
-            if (dijkstraTable[adjacentVertexIndex].visited == false)
-                edgeHeap.insert(edge);
-
-            // Check if this edge offers a better path cost to the adjacent vertex than what has so far.
-            int currentCost = dijkstraTable[adjacentVertexIndex].cost;
-            int newCost = dijkstraTable[vertexIndex].cost + edge.weight;
-            if (newCost < currentCost) {
-                dijkstraTable[adjacentVertexIndex].predecessor = vertex;
-                dijkstraTable[adjacentVertexIndex].cost = newCost;
-            }
-        }
+    DijkstraInfo* dijkstraTable = new DijkstraInfo[vertices.size()];
+    for (int i = 0; i < vertices.size(); i++) {
+        dijkstraTable[i].visited = denseTable[i].visited;
+        dijkstraTable[i].predecessor = 
+            (denseTable[i].predecessor == CompactGraph::NO_VERTEX) ? nullptr : &vertices[denseTable[i].predecessor];
+        dijkstraTable[i].cost = denseTable[i].cost;
+    }
+    dijkstraTable[originIndex].predecessor = &origin;
+
+    return dijkstraTable;
+}
+
+/*
+ * Dense id versions. These are written once against any graph type that offers vertexCount(), getTag(v) and 
+ * getEdges(v) (iterable as CompactEdge, which for CompressedGraph decodes as it goes), and exposed through plain 
+ * overloads in the header.
+*/
+
+/**
+ * @brief A candidate tree edge in Prim's algorithm, ordered by weight.
+ */
+struct PrimCandidate {
+    uint32_t from;
+    uint32_t to;
+    int32_t weight;
+
+    bool operator<(const PrimCandidate& other) const { return weight < other.weight; }
+};
+
+template <typename G>
+size_t adjacencyCount(const G& graph) {
+    size_t count = 0;
+    for (uint32_t i = 0; i < graph.vertexCount(); i++)
+        count += graph.getEdges(i).size();
+    return count;
+}
+
+template <typename G>
+CompactGraph* minimumSpanningTree_t(const G& graph) {
+    const uint32_t n = graph.vertexCount();
+    CompactGraph* result = new CompactGraph();
+    for (uint32_t i = 0; i < n; i++)
+        result->addVertex(graph.getTag(i));
+
+    // Every adjacency is pushed at most once: when its source vertex joins the tree.
+    std::vector<bool> inTree(n, false);
+    PriorityQueue<PrimCandidate> candidateHeap;
+    candidateHeap.reserve(adjacencyCount(graph));
 
-        // Point to the next unvisited vertex. How: keep extracting the next smallest edge from the heap until a vertex 
-        // has been found that has not been visited yet.
-        while (edgeHeap.getCount() > 0) {
-            const Edge& edge = edgeHeap.extractMinMax();
-            int vertexAIndex = graph.indexOfVertex(*edge.vertexA);
-            int vertexBIndex = graph.indexOfVertex(*edge.vertexB);
-            bool vertexAVisited = dijkstraTable[vertexAIndex].visited;
-            bool vertexBVisited = dijkstraTable[vertexBIndex].visited;
-            
-            if (vertexAVisited == false) {
-                vertex = edge.vertexA;
-                vertexIndex = vertexAIndex;
-            } else if (vertexBVisited == false) {
-                vertex = edge.vertexB;
-                vertexIndex = vertexBIndex;
+    for (uint32_t root = 0; root < n; root++) {
+        if (inTree[root])
+            continue;
+
+        uint32_t vertex = root;
+        while (true) {
+            // Add the vertex to the tree and offer every edge leading out of the tree.
+            inTree[vertex] = true;
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                if (!inTree[edge.target])
+                    candidateHeap.emplace(PrimCandidate{vertex, edge.target, edge.weight});
             }
-            if (vertexAVisited == false || vertexBVisited == false) {
-                dijkstraTable[vertexIndex].visited = true;
+
+            // The next tree edge is the lightest candidate whose far end is still outside the tree.
+            while (candidateHeap.getCount() > 0 && inTree[candidateHeap.getTop().to])
+                candidateHeap.pop();
+            if (candidateHeap.getCount() == 0)
                 break;
-            }
+            PrimCandidate next = candidateHeap.extractTop();
+            result->addEdge(next.from, next.to, next.weight);
+            vertex = next.to;
         }
+    }
+
+    return result;
+}
+
+void DijkstraWorkspace::reset(uint32_t vertexCount) {
+    for (uint32_t vertex : _touched)
+        _table[vertex] = {false, CompactGraph::NO_VERTEX, INT32_MAX};
+    _touched.clear();
+    _table.resize(vertexCount, {false, CompactGraph::NO_VERTEX, INT32_MAX});
+    _heap.clear();
+    _heap.reserve(vertexCount);
+}
+
+const std::vector<DenseDijkstraInfo>& DijkstraWorkspace::getTable() const {
+    return _table;
+}
+
+std::vector<DenseDijkstraInfo> DijkstraWorkspace::takeTable() {
+    _touched.clear();
+    return std::move(_table);
+}
+
+template <typename G>
+const std::vector<DenseDijkstraInfo>& indexedHeapShortestPath_t(const G& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace) {
+    workspace.reset(graph.vertexCount());
+    std::vector<DenseDijkstraInfo>& dijkstraTable = workspace._table;
+    IndexedHeap<int>& distanceHeap = workspace._heap;
+
+    dijkstraTable[origin].predecessor = origin;
+    dijkstraTable[origin].cost = 0;
+    workspace._touched.push_back(origin);
+    distanceHeap.insert(origin, 0);
 
-        // There are no more edges in the heap so there is nowhere to go. Algorithm is done.
-        if (edgeHeap.getCount() == 0)
-            working = false;
+    while (distanceHeap.getCount() > 0) {
+        uint32_t vertex = distanceHeap.extractMin();
+        dijkstraTable[vertex].visited = true;
+        int cost = dijkstraTable[vertex].cost;
+
+        for (CompactEdge edge : graph.getEdges(vertex)) {
+            DenseDijkstraInfo& adjacent = dijkstraTable[edge.target];
+            int64_t newCost = int64_t(cost) + edge.weight;
+            if (adjacent.visited || newCost >= adjacent.cost)
+                continue;
+
+            // An unreached vertex has cost INT32_MAX, so this is its first tentative path.
+            if (adjacent.cost == INT32_MAX)
+                workspace._touched.push_back(edge.target);
+            adjacent.predecessor = vertex;
+            adjacent.cost = newCost;
+            distanceHeap.insertOrDecrease(edge.target, newCost);
+        }
+    }
+
+    return dijkstraTable;
+}
+
+template <typename G>
+const std::vector<DenseDijkstraInfo>& radixHeapShortestPath_t(const G& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace) {
+    workspace.reset(graph.vertexCount());
+    std::vector<DenseDijkstraInfo>& dijkstraTable = workspace._table;
+    RadixHeap<uint32_t>& distanceHeap = workspace._radixHeap;
+    distanceHeap.clear();
+
+    dijkstraTable[origin].predecessor = origin;
+    dijkstraTable[origin].cost = 0;
+    workspace._touched.push_back(origin);
+    distanceHeap.push(0, origin);
+
+    while (!distanceHeap.isEmpty()) {
+        // A vertex is pushed again each time its cost improves. The first copy out has its final cost; later ones 
+        // are stale.
+        uint32_t vertex = distanceHeap.extractMin();
+        if (dijkstraTable[vertex].visited)
+            continue;
+        dijkstraTable[vertex].visited = true;
+        int cost = dijkstraTable[vertex].cost;
+
+        for (CompactEdge edge : graph.getEdges(vertex)) {
+            if (edge.weight < 0)
+                throw std::invalid_argument("A radix heap needs non-negative weights.");
+            DenseDijkstraInfo& adjacent = dijkstraTable[edge.target];
+            int64_t newCost = int64_t(cost) + edge.weight;
+            if (adjacent.visited || newCost >= adjacent.cost)
+                continue;
+
+            if (adjacent.cost == INT32_MAX)
+                workspace._touched.push_back(edge.target);
+            adjacent.predecessor = vertex;
+            adjacent.cost = newCost;
+            distanceHeap.push(newCost, edge.target);
+        }
     }
 
     return dijkstraTable;
 }
+
+template <typename G>
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath_t(const G& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue) {
+    if (queue == ShortestPathQueue::radixHeap)
+        return radixHeapShortestPath_t(graph, origin, workspace);
+    return indexedHeapShortestPath_t(graph, origin, workspace);
+}
+
+template <typename G>
+std::vector<DenseDijkstraInfo> singleSourceShortestPath_t(const G& graph, uint32_t origin, ShortestPathQueue queue) {
+    DijkstraWorkspace workspace;
+    singleSourceShortestPath_t(graph, origin, workspace, queue);
+    return workspace.takeTable();
+}
+
+CompactGraph* minimumSpanningTree(const CompactGraph& graph) {
+    return minimumSpanningTree_t(graph);
+}
+
+CompactGraph* minimumSpanningTree(const CsrGraph& graph) {
+    return minimumSpanningTree_t(graph);
+}
+
+CompactGraph* minimumSpanningTree(const CompressedGraph& graph) {
+    return minimumSpanningTree_t(graph);
+}
+
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CompactGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, queue);
+}
+
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CsrGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, queue);
+}
+
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CompressedGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, queue);
+}
+
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CompactGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, workspace, queue);
+}
+
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CsrGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, workspace, queue);
+}
+
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CompressedGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue) {
+    return singleSourceShortestPath_t(graph, origin, workspace, queue);
+}
@@ -1,10 +1,20 @@
 #pragma once
+#include <cstdint>
+#include <vector>
 #include "graph.h"
-#include "heap.h"
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+#include "indexed-heap.h"
+#include "priority-queue.h"
+#include "radix-heap.h"
 
 /**
  * @brief Finds the minimum spanning tree of an undirected, weighted graph. Uses Prim's algorithm.
  * 
+ * Every membership check scans the result's vertices, so this is quadratic; for large graphs use 
+ * kruskalSpanningForest or boruvkaSpanningForest (minimum-spanning-forest.h) on a CompactGraph or CsrGraph.
+ * 
  * @param graph the source graph to find the minimum spanning tree of
  * @return Graph* minimum spanning tree
  */
@@ -20,10 +30,190 @@ struct DijkstraInfo {
 };
 
 /**
- * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex.
+ * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex, indexed like 
+ * graph.getVertices(). Uses Dijkstra's algorithm. Weights must not be negative, and paths costing INT32_MAX or more 
+ * are left unreached.
+ * 
+ * Edges are matched to vertices by tag, as Graph does, through a tag map built on every call. For repeated queries, 
+ * convert the graph to a CompactGraph once and use the dense id overloads. Throws std::invalid_argument if origin is 
+ * not in the graph.
  * 
  * @param graph source graph
  * @param origin vertex to start from
  * @return DijkstraInfo* a table of shortest paths info
  */
 DijkstraInfo* singleSourceShortestPath(const Graph& graph, const Vertex& origin);
+
+
+/**
+ * @brief Finds the minimum spanning tree of an undirected, weighted compact graph. Uses Prim's algorithm, growing a 
+ * new tree from every vertex not yet reached, so a disconnected graph gives a minimum spanning forest.
+ * 
+ * @param graph the source graph to find the minimum spanning tree of
+ * @return CompactGraph* minimum spanning tree, with the same vertex ids as graph
+ */
+CompactGraph* minimumSpanningTree(const CompactGraph& graph);
+
+/**
+ * @brief Finds the minimum spanning tree (or forest) of an undirected, weighted CSR graph. Uses Prim's algorithm.
+ * 
+ * @param graph the source graph to find the minimum spanning tree of
+ * @return CompactGraph* minimum spanning tree, with the same vertex ids as graph
+ */
+CompactGraph* minimumSpanningTree(const CsrGraph& graph);
+
+/**
+ * @brief Finds the minimum spanning tree (or forest) of an undirected, weighted compressed graph. Uses Prim's 
+ * algorithm.
+ * 
+ * @param graph the source graph to find the minimum spanning tree of
+ * @return CompactGraph* minimum spanning tree, with the same vertex ids as graph
+ */
+CompactGraph* minimumSpanningTree(const CompressedGraph& graph);
+
+/**
+ * @brief Like DijkstraInfo, but the predecessor is a dense vertex id instead of a pointer. Unreachable vertices have 
+ * a predecessor of CompactGraph::NO_VERTEX and a cost of INT32_MAX; so do vertices whose shortest path costs 
+ * INT32_MAX or more.
+ */
+struct DenseDijkstraInfo {
+    bool visited;
+    uint32_t predecessor;
+    int cost;
+};
+
+/**
+ * @brief A tentative distance to a vertex, ordered by cost so it can be kept in a PriorityQueue.
+ */
+struct DistanceEntry {
+    int cost;
+    uint32_t vertex;
+
+    bool operator<(const DistanceEntry& other) const { return cost < other.cost; }
+};
+
+/**
+ * @brief Which priority queue Dijkstra's algorithm uses.
+ * 
+ * indexedHeap: a 4-ary heap with decreaseKey, so every vertex is in it at most once.
+ * 
+ * radixHeap: a RadixHeap, which never compares entries and costs amortized O(log C) per vertex for a heaviest edge 
+ * of C. Improved vertices are pushed again rather than moved. Usually faster when weights are small integers, such as 
+ * travel times on road networks.
+ */
+enum ShortestPathQueue {indexedHeap, radixHeap};
+
+/**
+ * @brief The table and heaps of a shortest path query, kept between queries so that repeated queries do not allocate. 
+ * Each query only resets the entries the previous one touched, so a query that explores a small part of a large 
+ * graph stays cheap.
+ */
+class DijkstraWorkspace {
+private:
+    std::vector<DenseDijkstraInfo> _table;
+    std::vector<uint32_t> _touched;
+    IndexedHeap<int> _heap;
+    RadixHeap<uint32_t> _radixHeap;
+
+    template <typename G>
+    friend const std::vector<DenseDijkstraInfo>& indexedHeapShortestPath_t(const G& graph, uint32_t origin, 
+        DijkstraWorkspace& workspace);
+    template <typename G>
+    friend const std::vector<DenseDijkstraInfo>& radixHeapShortestPath_t(const G& graph, uint32_t origin, 
+        DijkstraWorkspace& workspace);
+
+    /**
+     * @brief Resets the table to unreached for a graph of a given size.
+     * 
+     * @param vertexCount how many vertices the next query's graph has
+     */
+    void reset(uint32_t vertexCount);
+public:
+    DijkstraWorkspace() = default;
+
+    /**
+     * @brief Returns the table of the last query.
+     * 
+     * @return const std::vector<DenseDijkstraInfo>& a table of shortest paths info, indexed by vertex id
+     */
+    const std::vector<DenseDijkstraInfo>& getTable() const;
+
+    /**
+     * @brief Moves the table of the last query out of the workspace. The next query allocates a new one.
+     * 
+     * @return std::vector<DenseDijkstraInfo> a table of shortest paths info, indexed by vertex id
+     */
+    std::vector<DenseDijkstraInfo> takeTable();
+};
+
+/**
+ * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex, indexed by 
+ * vertex id. Uses Dijkstra's algorithm. Weights must not be negative.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param queue which priority queue to use
+ * @return std::vector<DenseDijkstraInfo> a table of shortest paths info
+ */
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CompactGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
+
+/**
+ * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex, indexed by 
+ * vertex id.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param queue which priority queue to use
+ * @return std::vector<DenseDijkstraInfo> a table of shortest paths info
+ */
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CsrGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
+
+/**
+ * @brief Returns a table of the shortest paths from a starting vertex to every other reachable vertex, indexed by 
+ * vertex id. Adjacency lists are decoded on the fly.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param queue which priority queue to use
+ * @return std::vector<DenseDijkstraInfo> a table of shortest paths info
+ */
+std::vector<DenseDijkstraInfo> singleSourceShortestPath(const CompressedGraph& graph, uint32_t origin, 
+    ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
+
+/**
+ * @brief Like singleSourceShortestPath, but reuses a workspace instead of allocating a new table.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param workspace memory kept between queries
+ * @param queue which priority queue to use
+ * @return const std::vector<DenseDijkstraInfo>& the workspace's table, valid until its next query
+ */
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CompactGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
+
+/**
+ * @brief Like singleSourceShortestPath, but reuses a workspace instead of allocating a new table.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param workspace memory kept between queries
+ * @param queue which priority queue to use
+ * @return const std::vector<DenseDijkstraInfo>& the workspace's table, valid until its next query
+ */
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CsrGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
+
+/**
+ * @brief Like singleSourceShortestPath, but reuses a workspace instead of allocating a new table.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param workspace memory kept between queries
+ * @param queue which priority queue to use
+ * @return const std::vector<DenseDijkstraInfo>& the workspace's table, valid until its next query
+ */
+const std::vector<DenseDijkstraInfo>& singleSourceShortestPath(const CompressedGraph& graph, uint32_t origin, 
+    DijkstraWorkspace& workspace, ShortestPathQueue queue = ShortestPathQueue::indexedHeap);
@@ -0,0 +1,133 @@
+#include "graph-reordering.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+/**
+ * @brief Appends a breadth first search from start to order, which doubles as the queue. Neighbours are visited in 
+ * adjacency order, or in order of increasing degree if byDegree is set.
+ */
+void breadthFirstOrder(const CsrGraph& graph, uint32_t start, bool byDegree, std::vector<bool>& visited, 
+        std::vector<uint32_t>& order) {
+    std::vector<uint32_t> neighbours;
+    visited[start] = true;
+    order.push_back(start);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+        neighbours.clear();
+        for (CompactEdge edge : graph.getEdges(order[head])) {
+            if (!visited[edge.target]) {
+                visited[edge.target] = true;
+                neighbours.push_back(edge.target);
+            }
+        }
+        if (byDegree) {
+            std::stable_sort(neighbours.begin(), neighbours.end(), [&graph](uint32_t a, uint32_t b) {
+                return graph.getEdges(a).size() < graph.getEdges(b).size();
+            });
+        }
+        order.insert(order.end(), neighbours.begin(), neighbours.end());
+    }
+}
+
+std::vector<uint32_t> vertexOrder(const CsrGraph& graph, VertexOrder order) {
+    const uint32_t n = graph.vertexCount();
+    std::vector<uint32_t> byId(n);
+    std::iota(byId.begin(), byId.end(), 0);
+
+    if (order == VertexOrder::degreeDescending) {
+        std::stable_sort(byId.begin(), byId.end(), [&graph](uint32_t a, uint32_t b) {
+            return graph.getEdges(a).size() > graph.getEdges(b).size();
+        });
+        return byId;
+    }
+
+    // Cuthill-McKee starts each component from its lowest degree vertex, which tends to be near the periphery.
+    if (order == VertexOrder::reverseCuthillMcKee) {
+        std::stable_sort(byId.begin(), byId.end(), [&graph](uint32_t a, uint32_t b) {
+            return graph.getEdges(a).size() < graph.getEdges(b).size();
+        });
+    }
+
+    std::vector<bool> visited(n, false);
+    std::vector<uint32_t> result;
+    result.reserve(n);
+    for (uint32_t start : byId) {
+        if (!visited[start])
+            breadthFirstOrder(graph, start, order == VertexOrder::reverseCuthillMcKee, visited, result);
+    }
+    if (order == VertexOrder::reverseCuthillMcKee)
+        std::reverse(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Builds one permuted CSR (forward or reverse). Each list is sorted by new target id.
+ */
+void permuteAdjacency(const CsrGraph& graph, bool reverse, const std::vector<uint32_t>& newToOld, 
+        const std::vector<uint32_t>& oldToNew, std::vector<uint64_t>& offsets, std::vector<uint32_t>& targets, 
+        std::vector<int32_t>& weights) {
+    const uint32_t n = graph.vertexCount();
+    offsets.assign((size_t)n + 1, 0);
+    targets.resize(graph.adjacencyCount());
+    weights.resize(graph.adjacencyCount());
+
+    std::vector<CompactEdge> list;
+    uint64_t next = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        offsets[v] = next;
+        list.clear();
+        CsrGraph::EdgeRange edges = reverse ? graph.getInEdges(newToOld[v]) : graph.getEdges(newToOld[v]);
+        for (CompactEdge edge : edges)
+            list.push_back({oldToNew[edge.target], edge.weight});
+        std::sort(list.begin(), list.end(), [](const CompactEdge& a, const CompactEdge& b) {
+            return (a.target != b.target) ? a.target < b.target : a.weight < b.weight;
+        });
+        for (CompactEdge edge : list) {
+            targets[next] = edge.target;
+            weights[next++] = edge.weight;
+        }
+    }
+    offsets[n] = next;
+}
+
+ReorderedGraph reorderVertices(const CsrGraph& graph, VertexOrder order) {
+    const uint32_t n = graph.vertexCount();
+    std::vector<uint32_t> newToOld = vertexOrder(graph, order);
+    std::vector<uint32_t> oldToNew(n);
+    for (uint32_t i = 0; i < n; i++)
+        oldToNew[newToOld[i]] = i;
+
+    TagArena tags;
+    tags.reserve(n, graph.getTagOffsets()[n]);
+    for (uint32_t i = 0; i < n; i++)
+        tags.intern(graph.getTag(newToOld[i]));
+
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<int32_t> weights;
+    permuteAdjacency(graph, false, newToOld, oldToNew, offsets, targets, weights);
+    if (graph.getType() == GraphType::undirected) {
+        CsrGraph reordered(std::move(offsets), std::move(targets), std::move(weights), std::move(tags));
+        return {std::move(reordered), std::move(newToOld), std::move(oldToNew)};
+    }
+
+    std::vector<uint64_t> inOffsets;
+    std::vector<uint32_t> inSources;
+    std::vector<int32_t> inWeights;
+    permuteAdjacency(graph, true, newToOld, oldToNew, inOffsets, inSources, inWeights);
+    CsrGraph reordered(std::move(offsets), std::move(targets), std::move(weights), std::move(inOffsets), 
+            std::move(inSources), std::move(inWeights), std::move(tags));
+    return {std::move(reordered), std::move(newToOld), std::move(oldToNew)};
+}
+
+std::vector<DenseDijkstraInfo> restoreOrder(const ReorderedGraph& reordered, 
+        const std::vector<DenseDijkstraInfo>& table) {
+    std::vector<DenseDijkstraInfo> result(table.size());
+    for (uint32_t v = 0; v < table.size(); v++) {
+        DenseDijkstraInfo info = table[v];
+        if (info.predecessor != CompactGraph::NO_VERTEX)
+            info.predecessor = reordered.newToOld[info.predecessor];
+        result[reordered.newToOld[v]] = info;
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "csr-graph.h"
+#include "graph-algorithms.h"
+
+/*
+ * Vertex ids normally follow insertion order, so the neighbours of a vertex can be anywhere in memory. Renumbering 
+ * the vertices so that neighbours get nearby ids makes traversals touch fewer cache lines and pages.
+ * 
+ * The reordered graph carries the original tags along, so anything reported by tag is unchanged. Tables indexed by id 
+ * can be translated back to the original ids with restoreOrder().
+*/
+
+/**
+ * @brief Which numbering to produce.
+ * 
+ * reverseCuthillMcKee: breadth first search from a low degree vertex of each component, visiting neighbours in order 
+ * of increasing degree, then reversed. Keeps the ids of adjacent vertices close together (small bandwidth).
+ * 
+ * breadthFirst: plain breadth first search order, one component after another.
+ * 
+ * degreeDescending: highest degree first, so the most frequently touched vertices share cache lines.
+ */
+enum VertexOrder {reverseCuthillMcKee, breadthFirst, degreeDescending};
+
+/**
+ * @brief A renumbered graph and the mapping between its ids and the original ones.
+ */
+struct ReorderedGraph {
+    CsrGraph graph;
+    std::vector<uint32_t> newToOld;
+    std::vector<uint32_t> oldToNew;
+};
+
+/**
+ * @brief Computes a new vertex numbering. Traversals follow out-edges.
+ * 
+ * O(V + E) for breadthFirst, O(V log V + E log d) for the others, where d is the largest degree.
+ * 
+ * @param graph the graph to number
+ * @param order which numbering to produce
+ * @return std::vector<uint32_t> newToOld: the original id of each new id
+ */
+std::vector<uint32_t> vertexOrder(const CsrGraph& graph, VertexOrder order);
+
+/**
+ * @brief Builds a renumbered copy of a graph. Each adjacency list is sorted by new target id.
+ * 
+ * @param graph the graph to renumber
+ * @param order which numbering to use
+ * @return ReorderedGraph the renumbered graph and the mapping in both directions
+ */
+ReorderedGraph reorderVertices(const CsrGraph& graph, VertexOrder order);
+
+/**
+ * @brief Translates a shortest paths table computed on a reordered graph back to the original ids.
+ * 
+ * @param reordered the reordered graph the table was computed on
+ * @param table the table, indexed by new id
+ * @return std::vector<DenseDijkstraInfo> the same table, indexed by and referring to original ids
+ */
+std::vector<DenseDijkstraInfo> restoreOrder(const ReorderedGraph& reordered, 
+        const std::vector<DenseDijkstraInfo>& table);
@@ -0,0 +1,407 @@
+#include "graph-traversal.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include "parallel.h"
+
+/*
+ * Switching thresholds from Beamer et al.: go bottom-up once the frontier has more than 1/ALPHA of the unexplored 
+ * edges, and back top-down once it has fewer than 1/BETA of the vertices and is shrinking.
+*/
+constexpr uint64_t ALPHA = 15;
+constexpr uint64_t BETA = 18;
+
+/**
+ * @brief The state shared by the threads of one breadth first search.
+ */
+struct BreadthFirstState {
+    std::vector<std::atomic<uint32_t>> parents;
+    std::vector<uint32_t> levels;
+    std::vector<uint32_t> queue;              // Frontier while going top-down.
+    std::vector<uint64_t> frontier;           // Frontier while going bottom-up, one bit per vertex.
+    std::vector<uint64_t> next;               // Next frontier while going bottom-up.
+    std::vector<std::vector<uint32_t>> found; // Per thread: vertices reached by the current top-down step.
+    std::vector<uint64_t> foundEdges;         // Per thread: out-edges of the vertices reached by the current step.
+    std::vector<uint64_t> foundCount;         // Per thread: how many vertices the current step reached.
+    std::atomic<size_t> cursor;
+    uint64_t unexploredEdges;
+    uint64_t frontierEdges;
+    uint64_t frontierCount;
+    uint32_t level;
+    bool bottomUp;
+    bool done;
+    Barrier barrier;
+
+    BreadthFirstState(uint32_t vertexCount, unsigned int threadCount) : parents(vertexCount), 
+            levels(vertexCount, BreadthFirstTree::UNREACHED), frontier((vertexCount + 63) / 64), 
+            next((vertexCount + 63) / 64), found(threadCount), foundEdges(threadCount), foundCount(threadCount), 
+            cursor(0), level(0), bottomUp(false), done(false), barrier(threadCount) {
+        for (std::atomic<uint32_t>& parent : parents)
+            parent.store(CompactGraph::NO_VERTEX, std::memory_order_relaxed);
+    }
+};
+
+template <typename G>
+void topDownStep(const G& graph, BreadthFirstState& state, unsigned int threadIndex) {
+    const size_t chunk = 64;
+    std::vector<uint32_t>& found = state.found[threadIndex];
+    uint64_t edges = 0;
+    size_t begin;
+    while ((begin = state.cursor.fetch_add(chunk, std::memory_order_relaxed)) < state.queue.size()) {
+        size_t end = std::min(begin + chunk, state.queue.size());
+        for (size_t i = begin; i < end; i++) {
+            uint32_t vertex = state.queue[i];
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                std::atomic<uint32_t>& parent = state.parents[edge.target];
+                uint32_t unvisited = CompactGraph::NO_VERTEX;
+                if (parent.load(std::memory_order_relaxed) == unvisited && 
+                        parent.compare_exchange_strong(unvisited, vertex, std::memory_order_relaxed)) {
+                    state.levels[edge.target] = state.level + 1;
+                    found.push_back(edge.target);
+                    edges += graph.getEdges(edge.target).size();
+                }
+            }
+        }
+    }
+    state.foundEdges[threadIndex] = edges;
+    state.foundCount[threadIndex] = found.size();
+}
+
+template <typename G>
+void bottomUpStep(const G& graph, BreadthFirstState& state, unsigned int threadIndex) {
+    // Whole words of the bitmap at a time, so no two threads write the same word of next.
+    const size_t chunk = 64;
+    const uint32_t n = graph.vertexCount();
+    uint64_t edges = 0;
+    uint64_t count = 0;
+    size_t begin;
+    while ((begin = state.cursor.fetch_add(chunk, std::memory_order_relaxed)) < state.next.size()) {
+        size_t end = std::min(begin + chunk, state.next.size());
+        for (size_t word = begin; word < end; word++) {
+            uint64_t bits = 0;
+            uint32_t last = std::min<uint64_t>(n, (word + 1) * 64);
+            for (uint32_t vertex = word * 64; vertex < last; vertex++) {
+                if (state.parents[vertex].load(std::memory_order_relaxed) != CompactGraph::NO_VERTEX)
+                    continue;
+                for (CompactEdge edge : graph.getInEdges(vertex)) {
+                    if (state.frontier[edge.target / 64] & (uint64_t(1) << (edge.target % 64))) {
+                        state.parents[vertex].store(edge.target, std::memory_order_relaxed);
+                        state.levels[vertex] = state.level + 1;
+                        bits |= uint64_t(1) << (vertex % 64);
+                        edges += graph.getEdges(vertex).size();
+                        count++;
+                        break;
+                    }
+                }
+            }
+            state.next[word] = bits;
+        }
+    }
+    state.foundEdges[threadIndex] = edges;
+    state.foundCount[threadIndex] = count;
+}
+
+/**
+ * @brief Run by thread 0 between steps: collects what the step found, picks the direction of the next step and puts 
+ * the frontier in the form that direction needs.
+ */
+void finishStep(BreadthFirstState& state, uint32_t vertexCount) {
+    uint64_t previousCount = state.frontierCount;
+    state.frontierEdges = 0;
+    state.frontierCount = 0;
+    for (size_t t = 0; t < state.found.size(); t++) {
+        state.frontierEdges += state.foundEdges[t];
+        state.frontierCount += state.foundCount[t];
+    }
+    state.unexploredEdges -= std::min(state.unexploredEdges, state.frontierEdges);
+    state.level++;
+    state.cursor.store(0, std::memory_order_relaxed);
+    if (state.frontierCount == 0) {
+        state.done = true;
+        return;
+    }
+
+    bool bottomUp;
+    if (!state.bottomUp)
+        bottomUp = state.frontierEdges > state.unexploredEdges / ALPHA;
+    else
+        bottomUp = !(state.frontierCount < vertexCount / BETA && state.frontierCount < previousCount);
+
+    if (!state.bottomUp && !bottomUp) {
+        state.queue.clear();
+        for (std::vector<uint32_t>& found : state.found) {
+            state.queue.insert(state.queue.end(), found.begin(), found.end());
+            found.clear();
+        }
+    } else if (!state.bottomUp && bottomUp) {
+        std::fill(state.frontier.begin(), state.frontier.end(), 0);
+        for (std::vector<uint32_t>& found : state.found) {
+            for (uint32_t vertex : found)
+                state.frontier[vertex / 64] |= uint64_t(1) << (vertex % 64);
+            found.clear();
+        }
+    } else if (state.bottomUp && bottomUp) {
+        state.frontier.swap(state.next);
+    } else {
+        state.queue.clear();
+        for (size_t word = 0; word < state.next.size(); word++) {
+            for (uint64_t bits = state.next[word]; bits != 0; bits &= bits - 1)
+                state.queue.push_back(word * 64 + __builtin_ctzll(bits));
+        }
+    }
+    state.bottomUp = bottomUp;
+}
+
+template <typename G>
+BreadthFirstTree breadthFirstSearch_t(const G& graph, uint32_t origin, unsigned int threadCount) {
+    const uint32_t n = graph.vertexCount();
+    threadCount = resolveThreadCount(threadCount);
+    BreadthFirstState state(n, threadCount);
+
+    state.unexploredEdges = 0;
+    for (uint32_t i = 0; i < n; i++)
+        state.unexploredEdges += graph.getEdges(i).size();
+    state.frontierEdges = graph.getEdges(origin).size();
+    state.frontierCount = 1;
+    state.unexploredEdges -= state.frontierEdges;
+    state.parents[origin].store(origin, std::memory_order_relaxed);
+    state.levels[origin] = 0;
+    state.queue.push_back(origin);
+
+    parallelRegion(threadCount, [&](unsigned int threadIndex) {
+        while (true) {
+            if (state.bottomUp)
+                bottomUpStep(graph, state, threadIndex);
+            else
+                topDownStep(graph, state, threadIndex);
+            state.barrier.wait();
+            if (threadIndex == 0)
+                finishStep(state, n);
+            state.barrier.wait();
+            if (state.done)
+                break;
+        }
+    });
+
+    BreadthFirstTree tree;
+    tree.levels = std::move(state.levels);
+    tree.parents.resize(n);
+    for (uint32_t i = 0; i < n; i++)
+        tree.parents[i] = state.parents[i].load(std::memory_order_relaxed);
+    return tree;
+}
+
+BreadthFirstTree breadthFirstSearch(const CompactGraph& graph, uint32_t origin, unsigned int threadCount) {
+    return breadthFirstSearch_t(graph, origin, threadCount);
+}
+
+BreadthFirstTree breadthFirstSearch(const CsrGraph& graph, uint32_t origin, unsigned int threadCount) {
+    return breadthFirstSearch_t(graph, origin, threadCount);
+}
+
+BreadthFirstTree breadthFirstSearch(const CompressedGraph& graph, uint32_t origin, unsigned int threadCount) {
+    return breadthFirstSearch_t(graph, origin, threadCount);
+}
+
+/*
+ * Depth first search keeps one frame per vertex on the current path: the vertex and where it is in its adjacency 
+ * list. A vertex is white (unvisited), grey (on the path) or black (finished); an edge to a grey vertex closes a 
+ * cycle.
+*/
+
+enum DepthFirstColour : uint8_t {white, grey, black};
+
+template <typename G>
+struct DepthFirstFrame {
+    using EdgeIterator = decltype(std::declval<const G&>().getEdges(0).begin());
+
+    uint32_t vertex;
+    EdgeIterator next;
+    EdgeIterator end;
+};
+
+/**
+ * @brief Depth first search from root over the white vertices. onBackEdge(vertex, target) is called for every edge to 
+ * a grey vertex.
+ */
+template <typename G, typename Pre, typename Post, typename BackEdge>
+void depthFirstVisit(const G& graph, uint32_t root, std::vector<DepthFirstColour>& colours, 
+        std::vector<DepthFirstFrame<G>>& stack, Pre onPre, Post onPost, BackEdge onBackEdge) {
+    colours[root] = DepthFirstColour::grey;
+    onPre(root);
+    stack.push_back({root, graph.getEdges(root).begin(), graph.getEdges(root).end()});
+
+    while (!stack.empty()) {
+        DepthFirstFrame<G>& frame = stack.back();
+        if (!(frame.next != frame.end)) {
+            colours[frame.vertex] = DepthFirstColour::black;
+            onPost(frame.vertex);
+            stack.pop_back();
+            continue;
+        }
+
+        uint32_t target = (*frame.next).target;
+        ++frame.next;
+        if (colours[target] == DepthFirstColour::white) {
+            colours[target] = DepthFirstColour::grey;
+            onPre(target);
+            stack.push_back({target, graph.getEdges(target).begin(), graph.getEdges(target).end()});
+        } else if (colours[target] == DepthFirstColour::grey) {
+            onBackEdge(frame.vertex, target);
+        }
+    }
+}
+
+template <typename G>
+void depthFirstSearch_t(const G& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit) {
+    std::vector<DepthFirstColour> colours(graph.vertexCount(), DepthFirstColour::white);
+    std::vector<DepthFirstFrame<G>> stack;
+    depthFirstVisit(graph, origin, colours, stack, 
+        [&](uint32_t vertex) { if (preVisit) preVisit(vertex); }, 
+        [&](uint32_t vertex) { if (postVisit) postVisit(vertex); }, 
+        [](uint32_t, uint32_t) {});
+}
+
+template <typename G>
+void depthFirstSearch_t(const G& graph, const VisitCallback& preVisit, const VisitCallback& postVisit) {
+    std::vector<DepthFirstColour> colours(graph.vertexCount(), DepthFirstColour::white);
+    std::vector<DepthFirstFrame<G>> stack;
+    for (uint32_t root = 0; root < graph.vertexCount(); root++) {
+        if (colours[root] != DepthFirstColour::white)
+            continue;
+        depthFirstVisit(graph, root, colours, stack, 
+            [&](uint32_t vertex) { if (preVisit) preVisit(vertex); }, 
+            [&](uint32_t vertex) { if (postVisit) postVisit(vertex); }, 
+            [](uint32_t, uint32_t) {});
+    }
+}
+
+template <typename G>
+std::vector<uint32_t> topologicalSort_t(const G& graph) {
+    const uint32_t n = graph.vertexCount();
+    std::vector<DepthFirstColour> colours(n, DepthFirstColour::white);
+    std::vector<DepthFirstFrame<G>> stack;
+
+    // Every vertex finishes after everything it leads to, so filling the order from the back gives a topological 
+    // order.
+    std::vector<uint32_t> order(n);
+    uint32_t position = n;
+    for (uint32_t root = 0; root < n; root++) {
+        if (colours[root] != DepthFirstColour::white)
+            continue;
+        depthFirstVisit(graph, root, colours, stack, 
+            [](uint32_t) {}, 
+            [&](uint32_t vertex) { order[--position] = vertex; }, 
+            [](uint32_t, uint32_t) { throw std::invalid_argument("Graph has a cycle."); });
+    }
+    return order;
+}
+
+/*
+ * A wave smaller than this is handled by the calling thread alone: starting threads costs more than the wave's work, 
+ * and long dependency chains have millions of one-vertex waves.
+*/
+constexpr size_t PARALLEL_WAVE_SIZE = 4096;
+
+template <typename G>
+TopologicalWaves topologicalWaves_t(const G& graph, unsigned int threadCount) {
+    const uint32_t n = graph.vertexCount();
+    threadCount = resolveThreadCount(threadCount);
+
+    TopologicalWaves waves;
+    waves.order.reserve(n);
+    waves.waveOffsets.push_back(0);
+    std::vector<std::atomic<uint32_t>> inDegrees(n);
+    std::vector<std::vector<uint32_t>> found(threadCount);
+
+    // The first wave is every vertex without in-edges.
+    parallelFor(n, threadCount, [&](size_t begin, size_t end, unsigned int threadIndex) {
+        for (size_t vertex = begin; vertex < end; vertex++) {
+            uint32_t inDegree = graph.getInEdges(vertex).size();
+            inDegrees[vertex].store(inDegree, std::memory_order_relaxed);
+            if (inDegree == 0)
+                found[threadIndex].push_back(vertex);
+        }
+    });
+
+    while (true) {
+        // Append what every thread found, in thread order, as the next wave.
+        size_t waveBegin = waves.order.size();
+        for (std::vector<uint32_t>& threadFound : found) {
+            waves.order.insert(waves.order.end(), threadFound.begin(), threadFound.end());
+            threadFound.clear();
+        }
+        size_t waveSize = waves.order.size() - waveBegin;
+        if (waveSize == 0)
+            break;
+        waves.waveOffsets.push_back(waves.order.size());
+
+        // Remove the wave's out-edges. A vertex whose last in-edge goes belongs to the next wave.
+        unsigned int waveThreads = (waveSize < PARALLEL_WAVE_SIZE) ? 1 : threadCount;
+        parallelFor(waveSize, waveThreads, [&](size_t begin, size_t end, unsigned int threadIndex) {
+            for (size_t i = waveBegin + begin; i < waveBegin + end; i++) {
+                for (CompactEdge edge : graph.getEdges(waves.order[i])) {
+                    if (inDegrees[edge.target].fetch_sub(1, std::memory_order_relaxed) == 1)
+                        found[threadIndex].push_back(edge.target);
+                }
+            }
+        });
+    }
+
+    if (waves.order.size() != n)
+        throw std::invalid_argument("Graph has a cycle.");
+    return waves;
+}
+
+void depthFirstSearch(const CompactGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, origin, preVisit, postVisit);
+}
+
+void depthFirstSearch(const CsrGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, origin, preVisit, postVisit);
+}
+
+void depthFirstSearch(const CompressedGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, origin, preVisit, postVisit);
+}
+
+void depthFirstSearch(const CompactGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, preVisit, postVisit);
+}
+
+void depthFirstSearch(const CsrGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, preVisit, postVisit);
+}
+
+void depthFirstSearch(const CompressedGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit) {
+    depthFirstSearch_t(graph, preVisit, postVisit);
+}
+
+std::vector<uint32_t> topologicalSort(const CompactGraph& graph) {
+    return topologicalSort_t(graph);
+}
+
+std::vector<uint32_t> topologicalSort(const CsrGraph& graph) {
+    return topologicalSort_t(graph);
+}
+
+std::vector<uint32_t> topologicalSort(const CompressedGraph& graph) {
+    return topologicalSort_t(graph);
+}
+
+TopologicalWaves topologicalWaves(const CompactGraph& graph, unsigned int threadCount) {
+    return topologicalWaves_t(graph, threadCount);
+}
+
+TopologicalWaves topologicalWaves(const CsrGraph& graph, unsigned int threadCount) {
+    return topologicalWaves_t(graph, threadCount);
+}
+
+TopologicalWaves topologicalWaves(const CompressedGraph& graph, unsigned int threadCount) {
+    return topologicalWaves_t(graph, threadCount);
+}
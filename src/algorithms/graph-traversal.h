@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+
+/**
+ * @brief The result of a breadth first search: how many hops each vertex is from the origin, and the vertex it was 
+ * reached from. Unreachable vertices have a level of UNREACHED and a parent of CompactGraph::NO_VERTEX. The origin is 
+ * its own parent.
+ */
+struct BreadthFirstTree {
+    constexpr static uint32_t UNREACHED = UINT32_MAX;
+
+    std::vector<uint32_t> levels;
+    std::vector<uint32_t> parents;
+};
+
+/**
+ * @brief Breadth first search from one vertex along out-edges, split over several threads. Direction optimizing 
+ * (Beamer, Asanovic and Patterson): while the frontier is small, each frontier vertex pushes to its unvisited 
+ * neighbours (top-down, frontier kept as a queue); once the frontier's edges outnumber a fraction of the unexplored 
+ * edges, each unvisited vertex instead pulls from its in-neighbours and stops at the first one in the frontier 
+ * (bottom-up, frontier kept as a bitmap). It switches back when the frontier shrinks again.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @return BreadthFirstTree levels and parents of every vertex
+ */
+BreadthFirstTree breadthFirstSearch(const CompactGraph& graph, uint32_t origin, unsigned int threadCount = 0);
+
+/**
+ * @brief See breadthFirstSearch(const CompactGraph&, ...).
+ */
+BreadthFirstTree breadthFirstSearch(const CsrGraph& graph, uint32_t origin, unsigned int threadCount = 0);
+
+/**
+ * @brief See breadthFirstSearch(const CompactGraph&, ...). Adjacency lists are decoded on the fly.
+ */
+BreadthFirstTree breadthFirstSearch(const CompressedGraph& graph, uint32_t origin, unsigned int threadCount = 0);
+
+/**
+ * @brief Called with a vertex id during a depth first search.
+ */
+using VisitCallback = std::function<void(uint32_t vertex)>;
+
+/**
+ * @brief Depth first search from one vertex along out-edges, using an explicit stack so that very deep graphs cannot 
+ * overflow the call stack. Neighbours are visited in adjacency order.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param preVisit called when a vertex is first reached; may be empty
+ * @param postVisit called once every vertex reachable from a vertex has been visited; may be empty
+ */
+void depthFirstSearch(const CompactGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit);
+
+/**
+ * @brief See depthFirstSearch(const CompactGraph&, uint32_t, ...).
+ */
+void depthFirstSearch(const CsrGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit);
+
+/**
+ * @brief See depthFirstSearch(const CompactGraph&, uint32_t, ...).
+ */
+void depthFirstSearch(const CompressedGraph& graph, uint32_t origin, const VisitCallback& preVisit, 
+        const VisitCallback& postVisit);
+
+/**
+ * @brief Depth first search of the whole graph: starts a new search from every vertex not yet visited, in id order.
+ * 
+ * @param graph source graph
+ * @param preVisit called when a vertex is first reached; may be empty
+ * @param postVisit called once every vertex reachable from a vertex has been visited; may be empty
+ */
+void depthFirstSearch(const CompactGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit);
+
+/**
+ * @brief See depthFirstSearch(const CompactGraph&, const VisitCallback&, const VisitCallback&).
+ */
+void depthFirstSearch(const CsrGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit);
+
+/**
+ * @brief See depthFirstSearch(const CompactGraph&, const VisitCallback&, const VisitCallback&).
+ */
+void depthFirstSearch(const CompressedGraph& graph, const VisitCallback& preVisit, const VisitCallback& postVisit);
+
+/**
+ * @brief Orders the vertices of a directed acyclic graph so that every edge goes from an earlier vertex to a later 
+ * one. Uses reverse depth first finish order. Throws std::invalid_argument if the graph has a cycle.
+ * 
+ * @param graph source graph
+ * @return std::vector<uint32_t> every vertex id, in topological order
+ */
+std::vector<uint32_t> topologicalSort(const CompactGraph& graph);
+
+/**
+ * @brief See topologicalSort(const CompactGraph&).
+ */
+std::vector<uint32_t> topologicalSort(const CsrGraph& graph);
+
+/**
+ * @brief See topologicalSort(const CompactGraph&).
+ */
+std::vector<uint32_t> topologicalSort(const CompressedGraph& graph);
+
+/**
+ * @brief A topological order split into waves. Wave i is order[waveOffsets[i]] up to order[waveOffsets[i + 1]]: the 
+ * vertices whose predecessors are all in earlier waves, so the vertices of one wave can run at the same time. The 
+ * order of vertices within a wave is unspecified.
+ */
+struct TopologicalWaves {
+    std::vector<uint32_t> order;
+    std::vector<size_t> waveOffsets;
+
+    size_t waveCount() const { return waveOffsets.size() - 1; }
+};
+
+/**
+ * @brief Kahn's algorithm, one wave at a time: the vertices of a large wave are split over threads, which remove 
+ * their out-edges and collect the vertices left with no incoming edges as the next wave. Throws std::invalid_argument 
+ * if the graph has a cycle.
+ * 
+ * @param graph source graph
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @return TopologicalWaves every vertex id in topological order, split into waves
+ */
+TopologicalWaves topologicalWaves(const CompactGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See topologicalWaves(const CompactGraph&, unsigned int).
+ */
+TopologicalWaves topologicalWaves(const CsrGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See topologicalWaves(const CompactGraph&, unsigned int).
+ */
+TopologicalWaves topologicalWaves(const CompressedGraph& graph, unsigned int threadCount = 0);
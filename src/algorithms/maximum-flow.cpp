@@ -0,0 +1,358 @@
+#include "maximum-flow.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief The residual graph and push-relabel state. Arcs of vertex v are arcs[offsets[v]] up to arcs[offsets[v + 1]].
+ */
+class PushRelabel {
+private:
+    constexpr static uint32_t NONE = UINT32_MAX;
+
+    const uint32_t _n;
+    const uint32_t _source;
+    const uint32_t _sink;
+    std::vector<uint64_t> _offsets;
+    std::vector<uint32_t> _heads;
+    std::vector<uint64_t> _reverse;
+    std::vector<int64_t> _residual;
+
+    std::vector<int64_t> _excess;
+    std::vector<uint32_t> _height;
+    std::vector<uint64_t> _currentArc;
+
+    // Phase one keeps every vertex below height n in a doubly linked list for its height, so a gap can be found and 
+    // everything above it lifted, and active vertices in a stack for their height.
+    std::vector<uint32_t> _labelHead;
+    std::vector<uint32_t> _next;
+    std::vector<uint32_t> _previous;
+    std::vector<std::vector<uint32_t>> _active;
+    int64_t _highestActive;
+    int64_t _highestLabel;
+    uint64_t _work;
+
+    void link(uint32_t vertex) {
+        uint32_t height = _height[vertex];
+        _previous[vertex] = NONE;
+        _next[vertex] = _labelHead[height];
+        if (_labelHead[height] != NONE)
+            _previous[_labelHead[height]] = vertex;
+        _labelHead[height] = vertex;
+        _highestLabel = std::max<int64_t>(_highestLabel, height);
+    }
+
+    void unlink(uint32_t vertex) {
+        if (_previous[vertex] != NONE)
+            _next[_previous[vertex]] = _next[vertex];
+        else
+            _labelHead[_height[vertex]] = _next[vertex];
+        if (_next[vertex] != NONE)
+            _previous[_next[vertex]] = _previous[vertex];
+    }
+
+    void activate(uint32_t vertex) {
+        _active[_height[vertex]].push_back(vertex);
+        _highestActive = std::max<int64_t>(_highestActive, _height[vertex]);
+    }
+
+    void push(uint32_t vertex, uint64_t arc, int64_t amount) {
+        _residual[arc] -= amount;
+        _residual[_reverse[arc]] += amount;
+        _excess[vertex] -= amount;
+        _excess[_heads[arc]] += amount;
+    }
+
+    /**
+     * @brief Sets every height to the length of the shortest residual path to the sink, or n if there is none, and 
+     * rebuilds the label lists and active stacks.
+     */
+    void globalRelabel() {
+        std::fill(_height.begin(), _height.end(), _n);
+        std::fill(_labelHead.begin(), _labelHead.end(), NONE);
+        for (std::vector<uint32_t>& stack : _active)
+            stack.clear();
+        _highestActive = -1;
+        _highestLabel = -1;
+
+        std::vector<uint32_t> queue;
+        queue.reserve(_n);
+        _height[_sink] = 0;
+        queue.push_back(_sink);
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t vertex = queue[head];
+            link(vertex);
+            if (_excess[vertex] > 0 && vertex != _sink)
+                activate(vertex);
+            for (uint64_t arc = _offsets[vertex]; arc < _offsets[vertex + 1]; arc++) {
+                uint32_t other = _heads[arc];
+                if (_height[other] == _n && other != _source && _residual[_reverse[arc]] > 0) {
+                    _height[other] = _height[vertex] + 1;
+                    queue.push_back(other);
+                }
+            }
+        }
+        for (uint32_t vertex = 0; vertex < _n; vertex++)
+            _currentArc[vertex] = _offsets[vertex];
+        _work = 0;
+    }
+
+    /**
+     * @brief Lifts every vertex at or above a height that has just emptied out of phase one: none of them can reach 
+     * the sink any more.
+     */
+    void gap(uint32_t emptyHeight) {
+        for (int64_t height = emptyHeight; height <= _highestLabel; height++) {
+            for (uint32_t vertex = _labelHead[height]; vertex != NONE; vertex = _next[vertex])
+                _height[vertex] = _n;
+            _labelHead[height] = NONE;
+        }
+        _highestLabel = int64_t(emptyHeight) - 1;
+    }
+
+    /**
+     * @brief Pushes a vertex's excess along admissible arcs, relabeling it whenever it runs out of them, until the 
+     * excess is gone or the vertex leaves phase one.
+     */
+    void discharge(uint32_t vertex) {
+        while (_excess[vertex] > 0) {
+            uint64_t end = _offsets[vertex + 1];
+            for (uint64_t& arc = _currentArc[vertex]; arc < end; arc++) {
+                uint32_t other = _heads[arc];
+                if (_residual[arc] > 0 && _height[vertex] == _height[other] + 1) {
+                    if (_excess[other] == 0 && other != _sink)
+                        activate(other);
+                    push(vertex, arc, std::min(_excess[vertex], _residual[arc]));
+                    if (_excess[vertex] == 0)
+                        return;
+                }
+            }
+
+            // Relabel to one above the lowest neighbour with spare capacity.
+            uint32_t oldHeight = _height[vertex];
+            uint32_t newHeight = _n;
+            for (uint64_t arc = _offsets[vertex]; arc < end; arc++) {
+                if (_residual[arc] > 0 && _height[_heads[arc]] + 1 < newHeight) {
+                    newHeight = _height[_heads[arc]] + 1;
+                    _currentArc[vertex] = arc;
+                }
+            }
+            _work += end - _offsets[vertex] + 12;
+
+            unlink(vertex);
+            if (_labelHead[oldHeight] == NONE) {
+                _height[vertex] = _n;
+                gap(oldHeight);
+                return;
+            }
+            _height[vertex] = newHeight;
+            if (newHeight >= _n)
+                return;
+            link(vertex);
+        }
+    }
+
+    /**
+     * @brief Phase two: sends the excess left on vertices cut off from the sink back to the source, with FIFO 
+     * push-relabel on heights measured towards the source.
+     */
+    void returnExcess() {
+        std::fill(_height.begin(), _height.end(), 2 * _n);
+        std::vector<uint32_t> queue;
+        _height[_source] = _n;
+        queue.push_back(_source);
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t vertex = queue[head];
+            for (uint64_t arc = _offsets[vertex]; arc < _offsets[vertex + 1]; arc++) {
+                uint32_t other = _heads[arc];
+                if (_height[other] == 2 * _n && other != _sink && _residual[_reverse[arc]] > 0) {
+                    _height[other] = _height[vertex] + 1;
+                    queue.push_back(other);
+                }
+            }
+        }
+
+        queue.clear();
+        for (uint32_t vertex = 0; vertex < _n; vertex++) {
+            _currentArc[vertex] = _offsets[vertex];
+            if (_excess[vertex] > 0 && vertex != _source && vertex != _sink)
+                queue.push_back(vertex);
+        }
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t vertex = queue[head];
+            while (_excess[vertex] > 0) {
+                uint64_t end = _offsets[vertex + 1];
+                for (uint64_t& arc = _currentArc[vertex]; arc < end && _excess[vertex] > 0; arc++) {
+                    uint32_t other = _heads[arc];
+                    if (_residual[arc] > 0 && _height[vertex] == _height[other] + 1) {
+                        if (_excess[other] == 0 && other != _source && other != _sink)
+                            queue.push_back(other);
+                        push(vertex, arc, std::min(_excess[vertex], _residual[arc]));
+                    }
+                }
+                if (_excess[vertex] == 0)
+                    break;
+
+                uint32_t newHeight = UINT32_MAX;
+                for (uint64_t arc = _offsets[vertex]; arc < end; arc++) {
+                    if (_residual[arc] > 0 && _height[_heads[arc]] + 1 < newHeight) {
+                        newHeight = _height[_heads[arc]] + 1;
+                        _currentArc[vertex] = arc;
+                    }
+                }
+                _height[vertex] = newHeight;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Builds the residual graph. Every adjacency becomes an arc with its weight as capacity, paired with a 
+     * reverse arc of capacity 0 at the far end. forwardArcs receives the arc of each adjacency, in adjacency order.
+     */
+    template <typename G>
+    PushRelabel(const G& graph, uint32_t source, uint32_t sink, std::vector<uint64_t>& forwardArcs) : 
+            _n(graph.vertexCount()), _source(source), _sink(sink), _offsets(_n + 1, 0) {
+        for (uint32_t vertex = 0; vertex < _n; vertex++) {
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                if (edge.weight < 0)
+                    throw std::invalid_argument("Maximum flow needs non-negative capacities.");
+                _offsets[vertex + 1]++;
+                _offsets[edge.target + 1]++;
+            }
+        }
+        for (uint32_t vertex = 0; vertex < _n; vertex++)
+            _offsets[vertex + 1] += _offsets[vertex];
+
+        const uint64_t arcCount = _offsets[_n];
+        _heads.resize(arcCount);
+        _reverse.resize(arcCount);
+        _residual.resize(arcCount);
+        forwardArcs.clear();
+        forwardArcs.reserve(arcCount / 2);
+        std::vector<uint64_t> cursor(_offsets.begin(), _offsets.end() - 1);
+        for (uint32_t vertex = 0; vertex < _n; vertex++) {
+            for (CompactEdge edge : graph.getEdges(vertex)) {
+                uint64_t forward = cursor[vertex]++;
+                uint64_t backward = cursor[edge.target]++;
+                _heads[forward] = edge.target;
+                _heads[backward] = vertex;
+                _reverse[forward] = backward;
+                _reverse[backward] = forward;
+                _residual[forward] = edge.weight;
+                _residual[backward] = 0;
+                forwardArcs.push_back(forward);
+            }
+        }
+
+        _excess.assign(_n, 0);
+        _height.assign(_n, 0);
+        _currentArc.assign(_n, 0);
+        _labelHead.assign(_n, NONE);
+        _next.assign(_n, NONE);
+        _previous.assign(_n, NONE);
+        _active.resize(_n);
+    }
+
+    /**
+     * @brief Computes the maximum flow, leaving it in the residual capacities.
+     * 
+     * @return int64_t the flow value
+     */
+    int64_t run() {
+        for (uint64_t arc = _offsets[_source]; arc < _offsets[_source + 1]; arc++) {
+            _excess[_source] += _residual[arc];
+            push(_source, arc, _residual[arc]);
+        }
+        globalRelabel();
+
+        const uint64_t relabelInterval = 6 * uint64_t(_n) + _offsets[_n] / 2;
+        while (_highestActive >= 0) {
+            std::vector<uint32_t>& stack = _active[_highestActive];
+            if (stack.empty()) {
+                _highestActive--;
+                continue;
+            }
+            uint32_t vertex = stack.back();
+            stack.pop_back();
+            if (_height[vertex] != _highestActive || _excess[vertex] == 0)
+                continue;
+
+            discharge(vertex);
+            if (_excess[vertex] > 0 && _height[vertex] < _n)
+                activate(vertex);
+            if (_work > relabelInterval)
+                globalRelabel();
+        }
+
+        returnExcess();
+        return _excess[_sink];
+    }
+
+    int64_t getFlow(uint64_t forwardArc, int32_t capacity) const {
+        return capacity - _residual[forwardArc];
+    }
+
+    /**
+     * @brief Marks the vertices reachable from the source through arcs with spare capacity.
+     */
+    std::vector<bool> sourceSide() const {
+        std::vector<bool> reached(_n, false);
+        std::vector<uint32_t> queue;
+        reached[_source] = true;
+        queue.push_back(_source);
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t vertex = queue[head];
+            for (uint64_t arc = _offsets[vertex]; arc < _offsets[vertex + 1]; arc++) {
+                if (_residual[arc] > 0 && !reached[_heads[arc]]) {
+                    reached[_heads[arc]] = true;
+                    queue.push_back(_heads[arc]);
+                }
+            }
+        }
+        return reached;
+    }
+};
+
+template <typename G>
+MaximumFlow maximumFlow_t(const G& graph, uint32_t source, uint32_t sink) {
+    if (source >= graph.vertexCount() || sink >= graph.vertexCount())
+        throw std::invalid_argument("Source and sink must be vertices of the graph.");
+    if (source == sink)
+        throw std::invalid_argument("Source and sink must be different vertices.");
+
+    std::vector<uint64_t> forwardArcs;
+    PushRelabel pushRelabel(graph, source, sink, forwardArcs);
+
+    MaximumFlow result;
+    result.value = pushRelabel.run();
+    result.edgeFlows.resize(forwardArcs.size());
+    size_t adjacency = 0;
+    for (uint32_t vertex = 0; vertex < graph.vertexCount(); vertex++) {
+        for (CompactEdge edge : graph.getEdges(vertex)) {
+            result.edgeFlows[adjacency] = pushRelabel.getFlow(forwardArcs[adjacency], edge.weight);
+            adjacency++;
+        }
+    }
+    result.sourceSide = pushRelabel.sourceSide();
+    return result;
+}
+
+MaximumFlow maximumFlow(const CompactGraph& graph, uint32_t source, uint32_t sink) {
+    return maximumFlow_t(graph, source, sink);
+}
+
+MaximumFlow maximumFlow(const CsrGraph& graph, uint32_t source, uint32_t sink) {
+    return maximumFlow_t(graph, source, sink);
+}
+
+MaximumFlow maximumFlow(const CompressedGraph& graph, uint32_t source, uint32_t sink) {
+    return maximumFlow_t(graph, source, sink);
+}
+
+MaximumFlow maximumFlow(const Graph& graph, const Vertex& source, const Vertex& sink) {
+    int sourceIndex = graph.indexOfVertex(source);
+    int sinkIndex = graph.indexOfVertex(sink);
+    if (sourceIndex == -1 || sinkIndex == -1)
+        throw std::invalid_argument("Source and sink must be vertices of the graph.");
+    return maximumFlow_t(CompactGraph(graph), sourceIndex, sinkIndex);
+}
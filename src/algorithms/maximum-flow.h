@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "graph.h"
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+
+/**
+ * @brief A maximum flow and the minimum cut that proves it.
+ * 
+ * edgeFlows has one entry per adjacency, in the order getEdges() lists them vertex by vertex: the flow along that 
+ * adjacency, never more than its weight. In an undirected graph each edge is listed from both ends and can carry flow 
+ * either way; the net flow is the difference of its two entries.
+ * 
+ * sourceSide marks the vertices still reachable from the source through edges with spare capacity. The edges from 
+ * them to the other vertices are full, and their weights add up to value.
+ */
+struct MaximumFlow {
+    int64_t value;
+    std::vector<int64_t> edgeFlows;
+    std::vector<bool> sourceSide;
+};
+
+/**
+ * @brief Finds a maximum flow from source to sink, using edge weights as capacities. Weights must not be negative.
+ * 
+ * Uses highest-label push-relabel on a flat residual graph: every vertex's arcs are contiguous, and every arc knows 
+ * the index of its reverse. Heights are recomputed now and then by a breadth first search back from the sink (global 
+ * relabeling), and when no vertex is left at some height, every vertex above it is lifted out of the search at once 
+ * (gap heuristic). A second pass returns any excess that cannot reach the sink to the source.
+ * 
+ * Throws std::invalid_argument if source or sink is not a vertex of the graph, or if they are the same vertex.
+ * 
+ * @param graph source graph
+ * @param source id of the vertex the flow starts from
+ * @param sink id of the vertex the flow ends at
+ * @return MaximumFlow the flow value, per-edge flows and the minimum cut
+ */
+MaximumFlow maximumFlow(const CompactGraph& graph, uint32_t source, uint32_t sink);
+
+/**
+ * @brief See maximumFlow(const CompactGraph&, ...).
+ */
+MaximumFlow maximumFlow(const CsrGraph& graph, uint32_t source, uint32_t sink);
+
+/**
+ * @brief See maximumFlow(const CompactGraph&, ...). Adjacency lists are decoded on the fly.
+ */
+MaximumFlow maximumFlow(const CompressedGraph& graph, uint32_t source, uint32_t sink);
+
+/**
+ * @brief See maximumFlow(const CompactGraph&, ...). edgeFlows follows the order of getEdges(), and sourceSide the 
+ * order of getVertices().
+ */
+MaximumFlow maximumFlow(const Graph& graph, const Vertex& source, const Vertex& sink);
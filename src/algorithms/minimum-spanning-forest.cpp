@@ -0,0 +1,181 @@
+#include "minimum-spanning-forest.h"
+#include <atomic>
+#include <stdexcept>
+#include "disjoint-set.h"
+#include "parallel.h"
+
+/**
+ * @brief An edge that may join the forest. The key is the weight with its sign bit flipped, so that unsigned order 
+ * is weight order.
+ */
+struct ForestCandidate {
+    uint32_t key;
+    uint32_t source;
+    uint32_t target;
+    uint64_t id;
+};
+
+inline uint32_t weightKey(int32_t weight) {
+    return uint32_t(weight) ^ 0x80000000u;
+}
+
+/**
+ * @brief Lists every edge once: undirected edges from their lower id end, directed edges as they are. Self loops 
+ * can never join a forest and are left out.
+ */
+template <typename G>
+std::vector<ForestCandidate> forestCandidates(const G& graph) {
+    std::vector<ForestCandidate> candidates;
+    const bool directed = graph.getType() == GraphType::directed;
+    uint64_t id = 0;
+    for (uint32_t vertex = 0; vertex < graph.vertexCount(); vertex++) {
+        for (CompactEdge edge : graph.getEdges(vertex)) {
+            if (edge.target != vertex && (directed || vertex < edge.target))
+                candidates.push_back({weightKey(edge.weight), vertex, edge.target, id});
+            id++;
+        }
+    }
+    return candidates;
+}
+
+/**
+ * @brief Stable LSD radix sort by key, a byte at a time. Passes where every key has the same byte are skipped.
+ */
+void radixSortByKey(std::vector<ForestCandidate>& candidates) {
+    if (candidates.empty())
+        return;
+    std::vector<ForestCandidate> buffer(candidates.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t counts[257] = {};
+        for (const ForestCandidate& candidate : candidates)
+            counts[((candidate.key >> shift) & 0xFF) + 1]++;
+        if (counts[((candidates[0].key >> shift) & 0xFF) + 1] == candidates.size())
+            continue;
+
+        for (int digit = 0; digit < 256; digit++)
+            counts[digit + 1] += counts[digit];
+        for (const ForestCandidate& candidate : candidates)
+            buffer[counts[(candidate.key >> shift) & 0xFF]++] = candidate;
+        candidates.swap(buffer);
+    }
+}
+
+template <typename G>
+MinimumSpanningForest kruskalSpanningForest_t(const G& graph) {
+    std::vector<ForestCandidate> candidates = forestCandidates(graph);
+    radixSortByKey(candidates);
+
+    MinimumSpanningForest forest;
+    forest.weight = 0;
+    DisjointSet trees(graph.vertexCount());
+    for (const ForestCandidate& candidate : candidates) {
+        if (trees.setCount() == 1)
+            break;
+        if (trees.unite(candidate.source, candidate.target)) {
+            forest.edges.push_back(candidate.id);
+            forest.weight += int32_t(candidate.key ^ 0x80000000u);
+        }
+    }
+    return forest;
+}
+
+template <typename G>
+MinimumSpanningForest boruvkaSpanningForest_t(const G& graph, unsigned int threadCount) {
+    const uint32_t n = graph.vertexCount();
+    threadCount = resolveThreadCount(threadCount);
+    std::vector<ForestCandidate> candidates = forestCandidates(graph);
+    if (candidates.size() >= UINT32_MAX)
+        throw std::length_error("Too many edges for Boruvka's algorithm.");
+
+    // The lightest edge leaving each tree so far, packed as key then candidate index so ties are broken consistently.
+    constexpr uint64_t NO_EDGE = UINT64_MAX;
+    std::vector<std::atomic<uint64_t>> lightest(n);
+    for (std::atomic<uint64_t>& edge : lightest)
+        edge.store(NO_EDGE, std::memory_order_relaxed);
+
+    ConcurrentDisjointSet trees(n);
+    std::vector<std::vector<uint64_t>> picked(threadCount);
+    std::vector<int64_t> pickedWeight(threadCount, 0);
+    std::vector<std::vector<ForestCandidate>> kept(threadCount);
+    auto offer = [&](uint32_t tree, uint64_t packed) {
+        uint64_t current = lightest[tree].load(std::memory_order_relaxed);
+        while (packed < current && 
+            !lightest[tree].compare_exchange_weak(current, packed, std::memory_order_relaxed));
+    };
+
+    while (!candidates.empty()) {
+        // Every edge between two trees is offered to both. No union runs in this phase, so find() returns each tree's 
+        // current root however the threads' path halving interleaves, and only roots ever get an offer.
+        parallelFor(candidates.size(), threadCount, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t i = begin; i < end; i++) {
+                uint32_t treeA = trees.find(candidates[i].source);
+                uint32_t treeB = trees.find(candidates[i].target);
+                if (treeA == treeB)
+                    continue;
+                uint64_t packed = (uint64_t(candidates[i].key) << 32) | i;
+                offer(treeA, packed);
+                offer(treeB, packed);
+            }
+        });
+
+        // Join every tree to its pick. An edge picked by both of its trees only joins them once.
+        parallelFor(n, threadCount, [&](size_t begin, size_t end, unsigned int threadIndex) {
+            for (size_t tree = begin; tree < end; tree++) {
+                uint64_t packed = lightest[tree].load(std::memory_order_relaxed);
+                if (packed == NO_EDGE)
+                    continue;
+                lightest[tree].store(NO_EDGE, std::memory_order_relaxed);
+                const ForestCandidate& candidate = candidates[uint32_t(packed)];
+                if (trees.unite(candidate.source, candidate.target)) {
+                    picked[threadIndex].push_back(candidate.id);
+                    pickedWeight[threadIndex] += int32_t(candidate.key ^ 0x80000000u);
+                }
+            }
+        });
+
+        // Drop the edges that now lie inside one tree.
+        for (std::vector<ForestCandidate>& threadKept : kept)
+            threadKept.clear();
+        parallelFor(candidates.size(), threadCount, [&](size_t begin, size_t end, unsigned int threadIndex) {
+            for (size_t i = begin; i < end; i++) {
+                if (trees.find(candidates[i].source) != trees.find(candidates[i].target))
+                    kept[threadIndex].push_back(candidates[i]);
+            }
+        });
+        candidates.clear();
+        for (std::vector<ForestCandidate>& threadKept : kept)
+            candidates.insert(candidates.end(), threadKept.begin(), threadKept.end());
+    }
+
+    MinimumSpanningForest forest;
+    forest.weight = 0;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        forest.edges.insert(forest.edges.end(), picked[t].begin(), picked[t].end());
+        forest.weight += pickedWeight[t];
+    }
+    return forest;
+}
+
+MinimumSpanningForest kruskalSpanningForest(const CompactGraph& graph) {
+    return kruskalSpanningForest_t(graph);
+}
+
+MinimumSpanningForest kruskalSpanningForest(const CsrGraph& graph) {
+    return kruskalSpanningForest_t(graph);
+}
+
+MinimumSpanningForest kruskalSpanningForest(const CompressedGraph& graph) {
+    return kruskalSpanningForest_t(graph);
+}
+
+MinimumSpanningForest boruvkaSpanningForest(const CompactGraph& graph, unsigned int threadCount) {
+    return boruvkaSpanningForest_t(graph, threadCount);
+}
+
+MinimumSpanningForest boruvkaSpanningForest(const CsrGraph& graph, unsigned int threadCount) {
+    return boruvkaSpanningForest_t(graph, threadCount);
+}
+
+MinimumSpanningForest boruvkaSpanningForest(const CompressedGraph& graph, unsigned int threadCount) {
+    return boruvkaSpanningForest_t(graph, threadCount);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+
+/**
+ * @brief The edges of a minimum spanning forest: one tree per connected component.
+ * 
+ * Edges are identified by adjacency id, their position when every vertex's getEdges() are listed one vertex after 
+ * another; for a CsrGraph that is the index accepted by getTarget() and getWeight(). An undirected edge is listed 
+ * from both ends and is reported by the copy at its lower id end. Directed edges are treated as undirected.
+ */
+struct MinimumSpanningForest {
+    std::vector<uint64_t> edges;
+    int64_t weight;
+};
+
+/**
+ * @brief Kruskal's algorithm: sorts the edges by weight with an LSD radix sort, then adds each edge that joins two 
+ * different trees, tracked with a DisjointSet. O(E α(V)) after the O(E) sort.
+ * 
+ * @param graph source graph
+ * @return MinimumSpanningForest the forest's edges, in order of increasing weight, and their total weight
+ */
+MinimumSpanningForest kruskalSpanningForest(const CompactGraph& graph);
+
+/**
+ * @brief See kruskalSpanningForest(const CompactGraph&).
+ */
+MinimumSpanningForest kruskalSpanningForest(const CsrGraph& graph);
+
+/**
+ * @brief See kruskalSpanningForest(const CompactGraph&).
+ */
+MinimumSpanningForest kruskalSpanningForest(const CompressedGraph& graph);
+
+/**
+ * @brief Boruvka's algorithm, split over several threads. Each round, every tree picks its lightest edge leaving it 
+ * (ties broken by adjacency id, so the picks can never form a cycle) and all picks are added at once through a 
+ * ConcurrentDisjointSet, at least halving the number of trees. Edges inside one tree are dropped between rounds. 
+ * O(E log V) work over at most log V rounds.
+ * 
+ * @param graph source graph
+ * @param threadCount how many threads to use; 0 uses one per hardware thread
+ * @return MinimumSpanningForest the forest's edges, in no particular order, and their total weight
+ */
+MinimumSpanningForest boruvkaSpanningForest(const CompactGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See boruvkaSpanningForest(const CompactGraph&, unsigned int).
+ */
+MinimumSpanningForest boruvkaSpanningForest(const CsrGraph& graph, unsigned int threadCount = 0);
+
+/**
+ * @brief See boruvkaSpanningForest(const CompactGraph&, unsigned int).
+ */
+MinimumSpanningForest boruvkaSpanningForest(const CompressedGraph& graph, unsigned int threadCount = 0);
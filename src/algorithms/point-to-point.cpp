@@ -0,0 +1,282 @@
+#include "point-to-point.h"
+#include <algorithm>
+#include <cmath>
+
+void PathWorkspace::reset(Side& side, uint32_t vertexCount) {
+    for (uint32_t vertex : side.touched) {
+        side.costs[vertex] = INT32_MAX;
+        side.predecessors[vertex] = CompactGraph::NO_VERTEX;
+        side.settled[vertex] = false;
+    }
+    side.touched.clear();
+    side.costs.resize(vertexCount, INT32_MAX);
+    side.predecessors.resize(vertexCount, CompactGraph::NO_VERTEX);
+    side.settled.resize(vertexCount, false);
+    side.heap.clear();
+    side.heap.reserve(vertexCount);
+}
+
+/**
+ * @brief The searches behind the point-to-point queries, with access to the workspace's tables.
+ */
+class PathSearch {
+public:
+    using Side = PathWorkspace::Side;
+
+    /**
+     * @brief Edges out of a vertex when searching forward, into it when searching backward.
+     */
+    template <bool Forward, typename G>
+    static decltype(auto) adjacent(const G& graph, uint32_t vertex) {
+        if constexpr (Forward)
+            return graph.getEdges(vertex);
+        else
+            return graph.getInEdges(vertex);
+    }
+
+    static void start(Side& side, uint32_t vertex, int key) {
+        side.costs[vertex] = 0;
+        side.predecessors[vertex] = vertex;
+        side.touched.push_back(vertex);
+        side.heap.insert(vertex, key);
+    }
+
+    /**
+     * @brief Settles the vertex at the top of a side's heap and relaxes its edges. Estimate gives the A* part of each 
+     * key; it is 0 for plain Dijkstra. onReach(vertex) is called for every vertex whose cost improves.
+     * 
+     * @return uint32_t the settled vertex
+     */
+    template <bool Forward, typename G, typename H, typename F>
+    static uint32_t settleNext(const G& graph, Side& side, H estimate, F onReach) {
+        uint32_t vertex = side.heap.extractMin();
+        side.settled[vertex] = true;
+        int cost = side.costs[vertex];
+        for (CompactEdge edge : adjacent<Forward>(graph, vertex)) {
+            // Costs stay below INT32_MAX, the unreached mark; longer paths are dropped and their keys saturate.
+            int64_t newCost = int64_t(cost) + edge.weight;
+            if (side.settled[edge.target] || newCost >= side.costs[edge.target])
+                continue;
+            if (side.costs[edge.target] == INT32_MAX)
+                side.touched.push_back(edge.target);
+            side.costs[edge.target] = newCost;
+            side.predecessors[edge.target] = vertex;
+            side.heap.insertOrDecrease(edge.target, int(std::min<int64_t>(newCost + estimate(edge.target), INT32_MAX)));
+            onReach(edge.target);
+        }
+        return vertex;
+    }
+
+    /**
+     * @brief Follows predecessors from a vertex back to where its side started, appending each vertex on the way.
+     */
+    static void walkBack(const Side& side, uint32_t vertex, std::vector<uint32_t>& path) {
+        while (true) {
+            path.push_back(vertex);
+            uint32_t predecessor = side.predecessors[vertex];
+            if (predecessor == vertex)
+                break;
+            vertex = predecessor;
+        }
+    }
+
+    template <typename G, typename H>
+    static ShortestPath unidirectional(const G& graph, uint32_t origin, uint32_t target, H estimate, 
+            PathWorkspace& workspace) {
+        Side& side = workspace._forward;
+        PathWorkspace::reset(side, graph.vertexCount());
+        start(side, origin, estimate(origin));
+
+        ShortestPath path = {INT32_MAX, {}, 0};
+        while (side.heap.getCount() > 0) {
+            uint32_t vertex = settleNext<true>(graph, side, estimate, [](uint32_t) {});
+            path.settledCount++;
+            if (vertex == target) {
+                path.cost = side.costs[target];
+                walkBack(side, target, path.vertices);
+                std::reverse(path.vertices.begin(), path.vertices.end());
+                break;
+            }
+        }
+        return path;
+    }
+
+    template <typename G>
+    static ShortestPath bidirectional(const G& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace) {
+        Side& forward = workspace._forward;
+        Side& backward = workspace._backward;
+        PathWorkspace::reset(forward, graph.vertexCount());
+        PathWorkspace::reset(backward, graph.vertexCount());
+        start(forward, origin, 0);
+        start(backward, target, 0);
+
+        // The best path through a vertex reached from both sides so far.
+        int64_t best = (origin == target) ? 0 : INT64_MAX;
+        uint32_t meeting = (origin == target) ? origin : CompactGraph::NO_VERTEX;
+        auto zero = [](uint32_t) { return 0; };
+        auto meet = [&](uint32_t vertex) {
+            if (forward.costs[vertex] != INT32_MAX && backward.costs[vertex] != INT32_MAX && 
+                    int64_t(forward.costs[vertex]) + backward.costs[vertex] < best) {
+                best = int64_t(forward.costs[vertex]) + backward.costs[vertex];
+                meeting = vertex;
+            }
+        };
+
+        ShortestPath path = {INT32_MAX, {}, 0};
+        while (forward.heap.getCount() > 0 && backward.heap.getCount() > 0) {
+            if (int64_t(forward.heap.getMinKey()) + backward.heap.getMinKey() >= best)
+                break;
+            if (forward.heap.getMinKey() <= backward.heap.getMinKey())
+                meet(settleNext<true>(graph, forward, zero, meet));
+            else
+                meet(settleNext<false>(graph, backward, zero, meet));
+            path.settledCount++;
+        }
+
+        if (meeting != CompactGraph::NO_VERTEX && best < INT32_MAX) {
+            path.cost = best;
+            walkBack(forward, meeting, path.vertices);
+            std::reverse(path.vertices.begin(), path.vertices.end());
+            path.vertices.pop_back();
+            walkBack(backward, meeting, path.vertices);
+        }
+        return path;
+    }
+
+    /**
+     * @brief A full search from one vertex, forward or backward, copying every cost into costs.
+     */
+    template <bool Forward>
+    static void allCosts(const CsrGraph& graph, uint32_t origin, int* costs) {
+        PathWorkspace workspace;
+        Side& side = workspace._forward;
+        PathWorkspace::reset(side, graph.vertexCount());
+        start(side, origin, 0);
+        auto zero = [](uint32_t) { return 0; };
+        while (side.heap.getCount() > 0)
+            settleNext<Forward>(graph, side, zero, [](uint32_t) {});
+        std::copy(side.costs.begin(), side.costs.end(), costs);
+    }
+};
+
+CoordinateHeuristic::CoordinateHeuristic(std::vector<double> x, std::vector<double> y, double costPerUnit) : 
+        _x(std::move(x)), _y(std::move(y)), _costPerUnit(costPerUnit) {}
+
+int CoordinateHeuristic::estimate(uint32_t vertex, uint32_t target) const {
+    double distance = std::hypot(_x[vertex] - _x[target], _y[vertex] - _y[target]);
+    return int(std::floor(distance * _costPerUnit));
+}
+
+void LandmarkHeuristic::addLandmark(const CsrGraph& graph, uint32_t landmark) {
+    size_t row = _landmarks.size() * size_t(_vertexCount);
+    _landmarks.push_back(landmark);
+    _from.resize(row + _vertexCount);
+    _to.resize(row + _vertexCount);
+    PathSearch::allCosts<true>(graph, landmark, _from.data() + row);
+    PathSearch::allCosts<false>(graph, landmark, _to.data() + row);
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const CsrGraph& graph, const std::vector<uint32_t>& landmarks) : 
+        _vertexCount(graph.vertexCount()) {
+    for (uint32_t landmark : landmarks)
+        addLandmark(graph, landmark);
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const CsrGraph& graph, uint32_t landmarkCount) : 
+        _vertexCount(graph.vertexCount()) {
+    if (_vertexCount == 0)
+        return;
+
+    // Distance from vertex 0 picks the first landmark; after that, the distance to the nearest landmark so far.
+    std::vector<int> nearest(_vertexCount);
+    PathSearch::allCosts<true>(graph, 0, nearest.data());
+    while (_landmarks.size() < landmarkCount) {
+        uint32_t farthest = CompactGraph::NO_VERTEX;
+        for (uint32_t vertex = 0; vertex < _vertexCount; vertex++) {
+            if (nearest[vertex] != INT32_MAX && nearest[vertex] > 0 && 
+                    (farthest == CompactGraph::NO_VERTEX || nearest[vertex] > nearest[farthest]))
+                farthest = vertex;
+        }
+        if (farthest == CompactGraph::NO_VERTEX)
+            break;
+
+        addLandmark(graph, farthest);
+        const int* from = _from.data() + (_landmarks.size() - 1) * size_t(_vertexCount);
+        for (uint32_t vertex = 0; vertex < _vertexCount; vertex++)
+            nearest[vertex] = std::min(nearest[vertex], from[vertex]);
+    }
+}
+
+const std::vector<uint32_t>& LandmarkHeuristic::getLandmarks() const {
+    return _landmarks;
+}
+
+int LandmarkHeuristic::estimate(uint32_t vertex, uint32_t target) const {
+    // For every landmark L: d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L).
+    int best = 0;
+    for (size_t row = 0; row < _from.size(); row += _vertexCount) {
+        int fromVertex = _from[row + vertex];
+        int fromTarget = _from[row + target];
+        if (fromVertex != INT32_MAX && fromTarget != INT32_MAX)
+            best = std::max(best, fromTarget - fromVertex);
+        int toVertex = _to[row + vertex];
+        int toTarget = _to[row + target];
+        if (toVertex != INT32_MAX && toTarget != INT32_MAX)
+            best = std::max(best, toVertex - toTarget);
+    }
+    return best;
+}
+
+template <typename G>
+ShortestPath shortestPath_t(const G& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace) {
+    return PathSearch::unidirectional(graph, origin, target, [](uint32_t) { return 0; }, workspace);
+}
+
+template <typename G>
+ShortestPath aStarShortestPath_t(const G& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace) {
+    return PathSearch::unidirectional(graph, origin, target, 
+        [&](uint32_t vertex) { return heuristic.estimate(vertex, target); }, workspace);
+}
+
+ShortestPath shortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace) {
+    return shortestPath_t(graph, origin, target, workspace);
+}
+
+ShortestPath shortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace) {
+    return shortestPath_t(graph, origin, target, workspace);
+}
+
+ShortestPath shortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace) {
+    return shortestPath_t(graph, origin, target, workspace);
+}
+
+ShortestPath bidirectionalShortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace) {
+    return PathSearch::bidirectional(graph, origin, target, workspace);
+}
+
+ShortestPath bidirectionalShortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace) {
+    return PathSearch::bidirectional(graph, origin, target, workspace);
+}
+
+ShortestPath bidirectionalShortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace) {
+    return PathSearch::bidirectional(graph, origin, target, workspace);
+}
+
+ShortestPath aStarShortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace) {
+    return aStarShortestPath_t(graph, origin, target, heuristic, workspace);
+}
+
+ShortestPath aStarShortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace) {
+    return aStarShortestPath_t(graph, origin, target, heuristic, workspace);
+}
+
+ShortestPath aStarShortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace) {
+    return aStarShortestPath_t(graph, origin, target, heuristic, workspace);
+}
@@ -0,0 +1,193 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "compressed-graph.h"
+#include "indexed-heap.h"
+
+/**
+ * @brief A shortest path between two vertices. vertices runs from the origin to the target, both included, and is 
+ * empty if the target cannot be reached, in which case cost is INT32_MAX. Paths costing INT32_MAX or more count as 
+ * unreachable. settledCount is how many vertices the search settled on the way, a measure of the work it did.
+ */
+struct ShortestPath {
+    int cost;
+    std::vector<uint32_t> vertices;
+    uint32_t settledCount;
+};
+
+/**
+ * @brief Estimates the cost of the shortest path from a vertex to a target, for A*. The estimate must never be more 
+ * than the real cost (admissible), and must not drop by more than an edge's weight along that edge (consistent), or 
+ * A* may return a longer path.
+ */
+class DistanceHeuristic {
+public:
+    virtual ~DistanceHeuristic() = default;
+
+    /**
+     * @brief Returns a lower bound on the cost from vertex to target.
+     */
+    virtual int estimate(uint32_t vertex, uint32_t target) const = 0;
+};
+
+/**
+ * @brief Straight line distance between vertex coordinates, times the least cost per unit of distance any edge has. 
+ * With edge weights that are at least their length times costPerUnit this is consistent.
+ */
+class CoordinateHeuristic : public DistanceHeuristic {
+private:
+    std::vector<double> _x;
+    std::vector<double> _y;
+    double _costPerUnit;
+
+public:
+    /**
+     * @param x the x coordinate of every vertex
+     * @param y the y coordinate of every vertex
+     * @param costPerUnit the least weight per unit of distance of any edge
+     */
+    CoordinateHeuristic(std::vector<double> x, std::vector<double> y, double costPerUnit);
+
+    int estimate(uint32_t vertex, uint32_t target) const override;
+};
+
+/**
+ * @brief ALT (A*, landmarks, triangle inequality): the cost from and to a few landmark vertices is computed up front 
+ * with single source searches, and the triangle inequality turns them into lower bounds for any pair. Landmarks on 
+ * the edge of the graph, far from each other, give the tightest bounds.
+ */
+class LandmarkHeuristic : public DistanceHeuristic {
+private:
+    uint32_t _vertexCount;
+    std::vector<uint32_t> _landmarks;
+    std::vector<int> _from; // Landmark by landmark: cost from the landmark to each vertex, or INT32_MAX.
+    std::vector<int> _to;   // Landmark by landmark: cost from each vertex to the landmark, or INT32_MAX.
+
+    void addLandmark(const CsrGraph& graph, uint32_t landmark);
+
+public:
+    /**
+     * @brief Uses the given landmarks. Runs two single source searches per landmark.
+     * 
+     * @param graph the graph that will be searched
+     * @param landmarks ids of the landmark vertices
+     */
+    LandmarkHeuristic(const CsrGraph& graph, const std::vector<uint32_t>& landmarks);
+
+    /**
+     * @brief Picks landmarks by farthest point selection: each new landmark is the reachable vertex farthest from the 
+     * landmarks so far, starting from the vertex farthest from vertex 0.
+     * 
+     * @param graph the graph that will be searched
+     * @param landmarkCount how many landmarks to pick
+     */
+    LandmarkHeuristic(const CsrGraph& graph, uint32_t landmarkCount);
+
+    const std::vector<uint32_t>& getLandmarks() const;
+
+    int estimate(uint32_t vertex, uint32_t target) const override;
+};
+
+/**
+ * @brief The tables and heaps of a point-to-point search, one set for each direction, kept between queries so that 
+ * repeated queries do not allocate. Each query only resets what the previous one touched.
+ */
+class PathWorkspace {
+private:
+    struct Side {
+        std::vector<int> costs;
+        std::vector<uint32_t> predecessors;
+        std::vector<bool> settled;
+        std::vector<uint32_t> touched;
+        IndexedHeap<int> heap;
+    };
+
+    Side _forward;
+    Side _backward;
+
+    /**
+     * @brief Resets a side to unreached for a graph of a given size, touching only what the last query touched.
+     */
+    static void reset(Side& side, uint32_t vertexCount);
+
+    friend class PathSearch;
+    friend class ContractionHierarchy;
+
+public:
+    PathWorkspace() = default;
+};
+
+/**
+ * @brief Dijkstra's algorithm from origin, stopping as soon as target is settled.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param target id of the vertex to reach
+ * @param workspace memory kept between queries
+ * @return ShortestPath the path and its cost
+ */
+ShortestPath shortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace);
+
+/**
+ * @brief See shortestPath(const CompactGraph&, ...).
+ */
+ShortestPath shortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace);
+
+/**
+ * @brief See shortestPath(const CompactGraph&, ...).
+ */
+ShortestPath shortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, PathWorkspace& workspace);
+
+/**
+ * @brief Dijkstra's algorithm from both ends at once, forward from origin along out-edges and backward from target 
+ * along in-edges, always advancing the side whose next vertex is closer. Stops once the two closest unsettled 
+ * vertices together cost at least the best path seen where the searches meet.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param target id of the vertex to reach
+ * @param workspace memory kept between queries
+ * @return ShortestPath the path and its cost
+ */
+ShortestPath bidirectionalShortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace);
+
+/**
+ * @brief See bidirectionalShortestPath(const CompactGraph&, ...).
+ */
+ShortestPath bidirectionalShortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace);
+
+/**
+ * @brief See bidirectionalShortestPath(const CompactGraph&, ...).
+ */
+ShortestPath bidirectionalShortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, 
+        PathWorkspace& workspace);
+
+/**
+ * @brief A* search: Dijkstra's algorithm with every vertex keyed by its cost plus the heuristic's estimate of the 
+ * rest of the way, so the search heads towards the target. Stops as soon as target is settled.
+ * 
+ * @param graph source graph
+ * @param origin id of the vertex to start from
+ * @param target id of the vertex to reach
+ * @param heuristic an admissible, consistent estimate of the remaining cost
+ * @param workspace memory kept between queries
+ * @return ShortestPath the path and its cost
+ */
+ShortestPath aStarShortestPath(const CompactGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace);
+
+/**
+ * @brief See aStarShortestPath(const CompactGraph&, ...).
+ */
+ShortestPath aStarShortestPath(const CsrGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace);
+
+/**
+ * @brief See aStarShortestPath(const CompactGraph&, ...).
+ */
+ShortestPath aStarShortestPath(const CompressedGraph& graph, uint32_t origin, uint32_t target, 
+        const DistanceHeuristic& heuristic, PathWorkspace& workspace);
@@ -0,0 +1,178 @@
+#include "shortest-path-service.h"
+#include <algorithm>
+#include <stdexcept>
+#include "parallel.h"
+
+int ShortestPathTree::distance(uint32_t target) const {
+    return table[target].cost;
+}
+
+std::vector<uint32_t> ShortestPathTree::path(uint32_t target) const {
+    std::vector<uint32_t> vertices;
+    if (!table[target].visited)
+        return vertices;
+    for (uint32_t vertex = target; vertex != origin; vertex = table[vertex].predecessor)
+        vertices.push_back(vertex);
+    vertices.push_back(origin);
+    std::reverse(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+size_t ShortestPathTree::byteSize() const {
+    return sizeof(ShortestPathTree) + table.capacity() * sizeof(DenseDijkstraInfo);
+}
+
+ShortestPathService::ShortestPathService(const VersionedGraph& graph, size_t memoryLimit, unsigned int threadCount) : 
+        _graph(graph), _memoryLimit(memoryLimit), _version(0), _cachedBytes(0), _hits(0), _misses(0), 
+        _stopping(false) {
+    unsigned int threads = resolveThreadCount(threadCount);
+    _workers.reserve(threads);
+    for (unsigned int t = 0; t < threads; t++)
+        _workers.emplace_back(&ShortestPathService::work, this);
+}
+
+ShortestPathService::~ShortestPathService() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobAdded.notify_all();
+    for (int i = 0; i < _workers.size(); i++)
+        _workers[i].join();
+}
+
+void ShortestPathService::work() {
+    DijkstraWorkspace workspace;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobAdded.wait(lock, [&] { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty())
+                return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        std::shared_ptr<ShortestPathTree> tree;
+        try {
+            singleSourceShortestPath(job.snapshot->graph, job.origin, workspace);
+            tree = std::make_shared<ShortestPathTree>();
+            tree->origin = job.origin;
+            tree->version = job.snapshot->version;
+            tree->table = workspace.getTable();
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                finish(job);
+            }
+            job.result.set_exception(std::current_exception());
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            insert(tree);
+            finish(job);
+        }
+        job.result.set_value(std::move(tree));
+    }
+}
+
+void ShortestPathService::finish(const Job& job) {
+    auto pending = _pending.find(job.origin);
+    if (pending != _pending.end() && pending->second.version == job.snapshot->version)
+        _pending.erase(pending);
+}
+
+void ShortestPathService::observeVersion(uint64_t version) {
+    if (version <= _version)
+        return;
+    _version = version;
+    _lru.clear();
+    _cached.clear();
+    _cachedBytes = 0;
+}
+
+void ShortestPathService::insert(const std::shared_ptr<const ShortestPathTree>& tree) {
+    observeVersion(tree->version);
+    size_t bytes = tree->byteSize();
+    if (tree->version != _version || _cached.count(tree->origin) != 0 || bytes > _memoryLimit)
+        return;
+    while (_cachedBytes + bytes > _memoryLimit) {
+        _cachedBytes -= _lru.back()->byteSize();
+        _cached.erase(_lru.back()->origin);
+        _lru.pop_back();
+    }
+    _lru.push_front(tree);
+    _cached[tree->origin] = _lru.begin();
+    _cachedBytes += bytes;
+}
+
+std::shared_future<std::shared_ptr<const ShortestPathTree>> ShortestPathService::enqueue(uint32_t origin, 
+        const std::shared_ptr<const GraphSnapshot>& snapshot) {
+    auto pending = _pending.find(origin);
+    if (pending != _pending.end() && pending->second.version == snapshot->version)
+        return pending->second.result;
+
+    Job job{origin, snapshot, {}};
+    std::shared_future<std::shared_ptr<const ShortestPathTree>> result = job.result.get_future().share();
+    _pending[origin] = {snapshot->version, result};
+    _jobs.push_back(std::move(job));
+    _jobAdded.notify_one();
+    return result;
+}
+
+std::shared_ptr<const ShortestPathTree> ShortestPathService::getTree(uint32_t origin) {
+    std::shared_ptr<const GraphSnapshot> snapshot = _graph.acquire();
+    if (origin >= snapshot->graph.vertexCount())
+        throw std::invalid_argument("Origin is not a vertex of the graph.");
+
+    std::shared_future<std::shared_ptr<const ShortestPathTree>> result;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        observeVersion(snapshot->version);
+        if (snapshot->version == _version) {
+            auto cached = _cached.find(origin);
+            if (cached != _cached.end()) {
+                _hits++;
+                _lru.splice(_lru.begin(), _lru, cached->second);
+                return *cached->second;
+            }
+        }
+        _misses++;
+        result = enqueue(origin, snapshot);
+    }
+    return result.get();
+}
+
+int ShortestPathService::distance(uint32_t origin, uint32_t target) {
+    std::shared_ptr<const ShortestPathTree> tree = getTree(origin);
+    if (target >= tree->table.size())
+        throw std::invalid_argument("Target is not a vertex of the graph.");
+    return tree->distance(target);
+}
+
+std::vector<uint32_t> ShortestPathService::path(uint32_t origin, uint32_t target) {
+    std::shared_ptr<const ShortestPathTree> tree = getTree(origin);
+    if (target >= tree->table.size())
+        throw std::invalid_argument("Target is not a vertex of the graph.");
+    return tree->path(target);
+}
+
+void ShortestPathService::prefetch(const std::vector<uint32_t>& origins) {
+    std::shared_ptr<const GraphSnapshot> snapshot = _graph.acquire();
+    std::lock_guard<std::mutex> lock(_mutex);
+    observeVersion(snapshot->version);
+    for (uint32_t origin : origins) {
+        if (origin >= snapshot->graph.vertexCount())
+            throw std::invalid_argument("Origin is not a vertex of the graph.");
+        if (snapshot->version != _version || _cached.count(origin) == 0)
+            enqueue(origin, snapshot);
+    }
+}
+
+CacheStatistics ShortestPathService::getStatistics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return {_hits, _misses, _cached.size(), _cachedBytes};
+}
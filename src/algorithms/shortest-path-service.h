@@ -0,0 +1,170 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "graph-algorithms.h"
+#include "versioned-graph.h"
+
+/**
+ * @brief The shortest paths from one origin to every vertex of one version of a graph.
+ */
+struct ShortestPathTree {
+    uint32_t origin;
+    uint64_t version;
+    std::vector<DenseDijkstraInfo> table;
+
+    /**
+     * @brief Returns the cost of the shortest path to a vertex, or INT32_MAX if it cannot be reached.
+     */
+    int distance(uint32_t target) const;
+
+    /**
+     * @brief Returns the vertices on the shortest path from the origin to a vertex, both included, or an empty vector 
+     * if it cannot be reached. O(path length).
+     */
+    std::vector<uint32_t> path(uint32_t target) const;
+
+    /**
+     * @brief Returns roughly how much memory the tree takes.
+     */
+    size_t byteSize() const;
+};
+
+/**
+ * @brief How a ShortestPathService's cache has done so far.
+ */
+struct CacheStatistics {
+    uint64_t hits;
+    uint64_t misses;
+    size_t cachedTrees;
+    size_t cachedBytes;
+};
+
+/**
+ * @brief Answers shortest path queries on a VersionedGraph, for traffic where most queries start from a small set of 
+ * origins.
+ * 
+ * The full shortest path tree of every origin asked about is kept in a cache bounded by memory and evicted least 
+ * recently used first, so repeated queries from a cached origin cost only the length of the path. Trees belong to the 
+ * graph version they were computed on: as soon as a query sees a newer version, the whole cache is dropped.
+ * 
+ * Misses are computed by a pool of worker threads, each with its own DijkstraWorkspace. Queries that miss on the same 
+ * origin at the same time share one computation. Every method is safe to call from any number of threads. Trees 
+ * handed out stay valid after they are evicted.
+ */
+class ShortestPathService {
+private:
+    struct Job {
+        uint32_t origin;
+        std::shared_ptr<const GraphSnapshot> snapshot;
+        std::promise<std::shared_ptr<const ShortestPathTree>> result;
+    };
+
+    struct Pending {
+        uint64_t version;
+        std::shared_future<std::shared_ptr<const ShortestPathTree>> result;
+    };
+
+    using LruList = std::list<std::shared_ptr<const ShortestPathTree>>;
+
+    const VersionedGraph& _graph;
+    const size_t _memoryLimit;
+
+    std::mutex _mutex;
+    uint64_t _version;                                     // The version every cached tree belongs to.
+    LruList _lru;                                          // Most recently used first.
+    std::unordered_map<uint32_t, LruList::iterator> _cached;
+    std::unordered_map<uint32_t, Pending> _pending;
+    size_t _cachedBytes;
+    uint64_t _hits;
+    uint64_t _misses;
+
+    std::condition_variable _jobAdded;
+    std::deque<Job> _jobs;
+    bool _stopping;
+    std::vector<std::thread> _workers;
+
+    /**
+     * @brief Takes jobs off the queue until the service stops.
+     */
+    void work();
+
+    /**
+     * @brief Stops sharing a job's future with new queries once its tree is done. The mutex must be held.
+     */
+    void finish(const Job& job);
+
+    /**
+     * @brief Drops every cached tree if a newer version has been seen. The mutex must be held.
+     */
+    void observeVersion(uint64_t version);
+
+    /**
+     * @brief Adds a computed tree to the cache, evicting the least recently used trees until it fits. The mutex must 
+     * be held.
+     */
+    void insert(const std::shared_ptr<const ShortestPathTree>& tree);
+
+    /**
+     * @brief Returns a future for the tree of an origin on a snapshot, queueing a job unless one is already computing 
+     * it. The mutex must be held.
+     */
+    std::shared_future<std::shared_ptr<const ShortestPathTree>> enqueue(uint32_t origin, 
+        const std::shared_ptr<const GraphSnapshot>& snapshot);
+
+public:
+    /**
+     * @brief Starts the worker pool.
+     * 
+     * @param graph the graph to answer queries on; must outlive the service
+     * @param memoryLimit how many bytes of trees the cache may hold
+     * @param threadCount how many worker threads to use; 0 uses one per hardware thread
+     */
+    ShortestPathService(const VersionedGraph& graph, size_t memoryLimit, unsigned int threadCount = 0);
+
+    ShortestPathService(const ShortestPathService& other) = delete;
+    ShortestPathService& operator=(const ShortestPathService& other) = delete;
+
+    /**
+     * @brief Finishes the queued jobs and stops the worker pool.
+     */
+    ~ShortestPathService();
+
+    /**
+     * @brief Returns the shortest path tree of an origin on the latest version of the graph, waiting for it to be 
+     * computed on a miss. Throws std::invalid_argument if the origin is not a vertex.
+     * 
+     * @param origin id of the vertex to start from
+     * @return std::shared_ptr<const ShortestPathTree> the tree
+     */
+    std::shared_ptr<const ShortestPathTree> getTree(uint32_t origin);
+
+    /**
+     * @brief Returns the cost of the shortest path between two vertices, or INT32_MAX if there is none.
+     */
+    int distance(uint32_t origin, uint32_t target);
+
+    /**
+     * @brief Returns the vertices on the shortest path between two vertices, both included, or an empty vector if 
+     * there is none.
+     */
+    std::vector<uint32_t> path(uint32_t origin, uint32_t target);
+
+    /**
+     * @brief Queues the trees of several origins on the worker pool without waiting for them, e.g. to warm the cache 
+     * after the graph changes. Origins that are cached or already being computed are skipped.
+     * 
+     * @param origins ids of the vertices to start from
+     */
+    void prefetch(const std::vector<uint32_t>& origins);
+
+    CacheStatistics getStatistics();
+};
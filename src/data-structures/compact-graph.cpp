@@ -0,0 +1,157 @@
+#include "compact-graph.h"
+#include <stdexcept>
+
+CompactGraph::CompactGraph() : CompactGraph(GraphType::undirected) { }
+
+CompactGraph::CompactGraph(GraphType type) {
+    _adjacencies = 0;
+    _type = type;
+}
+
+/**
+ * @brief Translates one vertex's adjacency list from Graph into compact form.
+ */
+void copyAdjacency(const CompactGraph& graph, const Vertex& vertex, const std::vector<Edge>& edges, 
+        std::vector<CompactEdge>& result) {
+    result.reserve(edges.size());
+    for (int j = 0; j < edges.size(); j++) {
+        const Edge& edge = edges[j];
+        const Vertex& adjacentVertex = (*edge.vertexA == vertex) ? *edge.vertexB : *edge.vertexA;
+        result.push_back({graph.indexOfTag(adjacentVertex.tag), edge.weight});
+    }
+}
+
+CompactGraph::CompactGraph(const Graph& graph) : CompactGraph(graph.getType()) {
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    for (int i = 0; i < vertices.size(); i++) {
+        if (addVertex(vertices[i].tag) != i)
+            throw std::invalid_argument("Graph has two vertices with the same tag.");
+    }
+
+    // Copy each adjacency list as is, translating the far endpoint of every edge into an id.
+    for (int i = 0; i < vertices.size(); i++) {
+        copyAdjacency(*this, vertices[i], graph.getEdges()[i], _edges[i]);
+        if (_type == GraphType::directed)
+            copyAdjacency(*this, vertices[i], graph.getInEdges()[i], _inEdges[i]);
+        _adjacencies += graph.getEdges()[i].size();
+    }
+}
+
+uint32_t CompactGraph::indexOfTag(std::string_view tag) const {
+    uint32_t vertex = _tags.find(tag);
+    return (vertex != NO_VERTEX && _removed[vertex]) ? NO_VERTEX : vertex;
+}
+
+bool CompactGraph::isRemoved(uint32_t vertex) const {
+    return _removed[vertex];
+}
+
+std::string_view CompactGraph::getTag(uint32_t vertex) const {
+    return _tags.get(vertex);
+}
+
+const TagArena& CompactGraph::getTags() const {
+    return _tags;
+}
+
+const std::vector<CompactEdge>& CompactGraph::getEdges(uint32_t vertex) const {
+    return _edges[vertex];
+}
+
+const std::vector<CompactEdge>& CompactGraph::getInEdges(uint32_t vertex) const {
+    return (_type == GraphType::directed) ? _inEdges[vertex] : _edges[vertex];
+}
+
+GraphType CompactGraph::getType() const {
+    return _type;
+}
+
+int CompactGraph::vertexCount() const {
+    return _edges.size();
+}
+
+int CompactGraph::edgeCount() const {
+    return (_type == GraphType::directed) ? _adjacencies : _adjacencies / 2;
+}
+
+uint32_t CompactGraph::addVertex(std::string_view tag) {
+    uint32_t vertex = _tags.intern(tag);
+    if (vertex == _edges.size()) {
+        _edges.emplace_back();
+        if (_type == GraphType::directed)
+            _inEdges.emplace_back();
+        _removed.push_back(false);
+    }
+    _removed[vertex] = false;
+    return vertex;
+}
+
+void CompactGraph::addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    _edges[vertexA].push_back({vertexB, weight});
+    _adjacencies++;
+    if (_type == GraphType::directed) {
+        _inEdges[vertexB].push_back({vertexA, weight});
+    } else if (vertexB != vertexA) {
+        _edges[vertexB].push_back({vertexA, weight});
+        _adjacencies++;
+    }
+}
+
+int CompactGraph::findInList(const std::vector<CompactEdge>& list, uint32_t target, const int32_t* weight) {
+    for (int i = 0; i < list.size(); i++) {
+        if (list[i].target == target && (weight == nullptr || list[i].weight == *weight))
+            return i;
+    }
+    return -1;
+}
+
+bool CompactGraph::removeEdge(uint32_t vertexA, uint32_t vertexB) {
+    int index = findInList(_edges[vertexA], vertexB);
+    if (index == -1)
+        return false;
+
+    // The mirror entry must have the same weight, in case there are parallel edges listed in a different order.
+    int32_t weight = _edges[vertexA][index].weight;
+    _edges[vertexA][index] = _edges[vertexA].back();
+    _edges[vertexA].pop_back();
+    _adjacencies--;
+
+    std::vector<CompactEdge>* mirror = nullptr;
+    if (_type == GraphType::directed)
+        mirror = &_inEdges[vertexB];
+    else if (vertexB != vertexA)
+        mirror = &_edges[vertexB];
+    if (mirror != nullptr) {
+        int mirrorIndex = findInList(*mirror, vertexA, &weight);
+        (*mirror)[mirrorIndex] = mirror->back();
+        mirror->pop_back();
+        if (_type == GraphType::undirected)
+            _adjacencies--;
+    }
+    return true;
+}
+
+bool CompactGraph::updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    int index = findInList(_edges[vertexA], vertexB);
+    if (index == -1)
+        return false;
+
+    int32_t oldWeight = _edges[vertexA][index].weight;
+    _edges[vertexA][index].weight = weight;
+    if (_type == GraphType::directed)
+        _inEdges[vertexB][findInList(_inEdges[vertexB], vertexA, &oldWeight)].weight = weight;
+    else if (vertexB != vertexA)
+        _edges[vertexB][findInList(_edges[vertexB], vertexA, &oldWeight)].weight = weight;
+    return true;
+}
+
+void CompactGraph::removeVertex(uint32_t vertex) {
+    // Remove the vertex from the far end of each of its edges, then drop its own lists.
+    while (!_edges[vertex].empty())
+        removeEdge(vertex, _edges[vertex].back().target);
+    if (_type == GraphType::directed) {
+        while (!_inEdges[vertex].empty())
+            removeEdge(_inEdges[vertex].back().target, vertex);
+    }
+    _removed[vertex] = true;
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "graph.h"
+#include "tag-arena.h"
+
+/*
+ * A compact alternative to Graph. Vertices are dense integer ids (0, 1, 2, ...), tags are interned once in a 
+ * TagArena, and an adjacency entry is just the id of the other vertex and the weight. The graph owns all of its data, 
+ * so there are no pointers into caller-owned arrays that could dangle.
+ * 
+ * An Edge in Graph is two pointers and an int (24 bytes on a 64-bit machine) and is stored once per endpoint. A 
+ * CompactEdge is 8 bytes, so roughly three times as many edges fit in the same amount of memory.
+ * 
+ * Removing a vertex removes its edges but keeps its id, so ids held elsewhere stay valid. vertexCount() is therefore 
+ * the range of ids rather than the number of live vertices. Adding a removed vertex's tag again revives its id.
+*/
+
+struct CompactEdge {
+    uint32_t target;
+    int32_t weight;
+};
+
+class CompactGraph {
+private:
+    TagArena _tags;
+    std::vector<std::vector<CompactEdge>> _edges;
+    std::vector<std::vector<CompactEdge>> _inEdges; // Only used by directed graphs. Targets are the edges' sources.
+    int _adjacencies;
+    GraphType _type;
+    std::vector<bool> _removed;
+
+    /**
+     * @brief Returns the index of the first edge to target in a list, optionally with a given weight.
+     * 
+     * @return int the edge's index, or -1 if there is no such edge
+     */
+    static int findInList(const std::vector<CompactEdge>& list, uint32_t target, const int32_t* weight = nullptr);
+
+public:
+    constexpr static uint32_t NO_VERTEX = TagArena::NOT_FOUND;
+
+    CompactGraph();
+    explicit CompactGraph(GraphType type);
+
+    /**
+     * @brief Copies a Graph into compact storage, keeping its type. Vertex ids follow the order of graph.getVertices().
+     * Throws std::invalid_argument if two vertices share a tag, since edges are matched to vertices by tag.
+     * 
+     * @param graph the graph to copy
+     */
+    explicit CompactGraph(const Graph& graph);
+
+    ~CompactGraph() = default;
+
+    /**
+     * @brief Returns the id of the vertex with the given tag in O(1) expected time.
+     * 
+     * @param tag the vertex's tag
+     * @return uint32_t the vertex's id, or NO_VERTEX if there is no such vertex (or it was removed)
+     */
+    uint32_t indexOfTag(std::string_view tag) const;
+
+    /**
+     * @brief Returns whether a vertex has been removed.
+     * 
+     * @param vertex the vertex's id
+     * @return bool true if the vertex was removed and has not been added again
+     */
+    bool isRemoved(uint32_t vertex) const;
+
+    /**
+     * @brief Returns the tag of a vertex. The view is invalidated by the next call to addVertex().
+     * 
+     * @param vertex the vertex's id
+     * @return std::string_view the vertex's tag
+     */
+    std::string_view getTag(uint32_t vertex) const;
+
+    const TagArena& getTags() const;
+
+    /**
+     * @brief Returns the adjacency list of a vertex.
+     * 
+     * @param vertex the vertex's id
+     * @return const std::vector<CompactEdge>& every edge leaving the vertex
+     */
+    const std::vector<CompactEdge>& getEdges(uint32_t vertex) const;
+
+    /**
+     * @brief Returns the edges arriving at a vertex, where each edge's target is the vertex it comes from. For an 
+     * undirected graph this is the same as getEdges().
+     * 
+     * @param vertex the vertex's id
+     * @return const std::vector<CompactEdge>& every edge arriving at the vertex
+     */
+    const std::vector<CompactEdge>& getInEdges(uint32_t vertex) const;
+
+    GraphType getType() const;
+
+    int vertexCount() const;
+    int edgeCount() const;
+
+    /**
+     * @brief Adds a vertex, or does nothing if a vertex with the same tag already exists.
+     * 
+     * @param tag the vertex's tag
+     * @return uint32_t the vertex's id
+     */
+    uint32_t addVertex(std::string_view tag);
+
+    /**
+     * @brief Adds an edge between two existing vertices in O(1) amortized time. In a directed graph the edge goes from 
+     * vertexA to vertexB.
+     * 
+     * @param vertexA id of one endpoint (the source, if directed)
+     * @param vertexB id of the other endpoint (the destination, if directed)
+     * @param weight the edge's weight
+     */
+    void addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+
+    /**
+     * @brief Removes one edge between two vertices, in O(degree) time. If there are parallel edges only the first one 
+     * found is removed.
+     * 
+     * @param vertexA id of one endpoint (the source, if directed)
+     * @param vertexB id of the other endpoint (the destination, if directed)
+     * @return bool true if there was such an edge
+     */
+    bool removeEdge(uint32_t vertexA, uint32_t vertexB);
+
+    /**
+     * @brief Changes the weight of one edge between two vertices, in O(degree) time.
+     * 
+     * @param vertexA id of one endpoint (the source, if directed)
+     * @param vertexB id of the other endpoint (the destination, if directed)
+     * @param weight the edge's new weight
+     * @return bool true if there was such an edge
+     */
+    bool updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+
+    /**
+     * @brief Removes a vertex and every edge touching it. The id is not reused by other tags.
+     * 
+     * @param vertex the vertex's id
+     */
+    void removeVertex(uint32_t vertex);
+};
@@ -0,0 +1,120 @@
+#include "compressed-graph.h"
+#include <algorithm>
+
+/**
+ * @brief Appends a LEB128 varint.
+ */
+void encodeVarint(std::vector<uint8_t>& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((uint8_t)value);
+}
+
+/**
+ * @brief Appends four values as one group varint: a control byte of 2-bit length codes, then each value in 1-4 bytes.
+ */
+void encodeGroup(std::vector<uint8_t>& bytes, const uint32_t values[4]) {
+    size_t controlIndex = bytes.size();
+    bytes.push_back(0);
+    uint8_t control = 0;
+    for (int i = 0; i < 4; i++) {
+        uint32_t length = (values[i] < (1u << 8)) ? 1 : (values[i] < (1u << 16)) ? 2 : (values[i] < (1u << 24)) ? 3 : 4;
+        control |= (length - 1) << (2 * i);
+        for (uint32_t b = 0; b < length; b++)
+            bytes.push_back((uint8_t)(values[i] >> (8 * b)));
+    }
+    bytes[controlIndex] = control;
+}
+
+void CompressedGraph::encodeList(uint32_t vertex, std::vector<CompactEdge>& list) {
+    std::sort(list.begin(), list.end(), [](const CompactEdge& a, const CompactEdge& b) {
+        return (a.target != b.target) ? a.target < b.target : a.weight < b.weight;
+    });
+    encodeVarint(_bytes, list.size());
+
+    // Two edges per group. An odd last edge is padded with a zero gap and weight that are never decoded.
+    uint32_t values[4];
+    for (size_t i = 0; i < list.size(); i += 2) {
+        for (size_t j = 0; j < 2; j++) {
+            size_t index = i + j;
+            if (index >= list.size()) {
+                values[2 * j] = 0;
+                values[2 * j + 1] = 0;
+                continue;
+            }
+            uint32_t previous = (index == 0) ? vertex : list[index - 1].target;
+            values[2 * j] = (index == 0) ? zigzag((int32_t)(list[index].target - previous)) 
+                    : list[index].target - previous;
+            values[2 * j + 1] = zigzag(list[index].weight);
+        }
+        encodeGroup(_bytes, values);
+    }
+}
+
+CompressedGraph::CompressedGraph(const CsrGraph& graph) {
+    _vertexCount = graph.vertexCount();
+    _adjacencyCount = graph.adjacencyCount();
+    _type = graph.getType();
+    _tags.reserve(_vertexCount, graph.getTagOffsets()[_vertexCount]);
+    for (uint32_t i = 0; i < _vertexCount; i++)
+        _tags.intern(graph.getTag(i));
+
+    std::vector<CompactEdge> list;
+    _offsets.resize((size_t)_vertexCount + 1);
+    for (uint32_t i = 0; i < _vertexCount; i++) {
+        _offsets[i] = _bytes.size();
+        list.clear();
+        for (CompactEdge edge : graph.getEdges(i))
+            list.push_back(edge);
+        encodeList(i, list);
+    }
+    _offsets[_vertexCount] = _bytes.size();
+
+    if (_type == GraphType::directed) {
+        _inOffsets.resize((size_t)_vertexCount + 1);
+        for (uint32_t i = 0; i < _vertexCount; i++) {
+            _inOffsets[i] = _bytes.size();
+            list.clear();
+            for (CompactEdge edge : graph.getInEdges(i))
+                list.push_back(edge);
+            encodeList(i, list);
+        }
+        _inOffsets[_vertexCount] = _bytes.size();
+    }
+
+    // A group's last value may be read with a 4 byte load starting at its last byte.
+    _bytes.resize(_bytes.size() + 3, 0);
+    _bytes.shrink_to_fit();
+}
+
+CompressedGraph::CompressedGraph(const CompactGraph& graph) : CompressedGraph(CsrGraph(graph)) { }
+
+uint32_t CompressedGraph::indexOfTag(std::string_view tag) const {
+    return _tags.find(tag);
+}
+
+std::string_view CompressedGraph::getTag(uint32_t vertex) const {
+    return _tags.get(vertex);
+}
+
+GraphType CompressedGraph::getType() const {
+    return _type;
+}
+
+uint32_t CompressedGraph::vertexCount() const {
+    return _vertexCount;
+}
+
+uint64_t CompressedGraph::adjacencyCount() const {
+    return _adjacencyCount;
+}
+
+uint64_t CompressedGraph::edgeCount() const {
+    return (_type == GraphType::directed) ? _adjacencyCount : _adjacencyCount / 2;
+}
+
+size_t CompressedGraph::byteSize() const {
+    return _bytes.size() + (_offsets.size() + _inOffsets.size()) * sizeof(uint64_t);
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "compact-graph.h"
+#include "csr-graph.h"
+#include "tag-arena.h"
+
+/*
+ * A read-only graph whose adjacency lists are compressed. Each list is sorted by target and stored as a byte stream:
+ * 
+ *     varint degree, then for each edge: target gap, zigzag weight
+ * 
+ * The first target gap is the zigzag encoded difference from the vertex's own id and every later gap is the difference 
+ * from the previous target, so lists of nearby ids (e.g. after reorderVertices()) become mostly one byte values. Gaps 
+ * and weights are packed with group varint: one control byte holds the byte lengths of the next four values, which 
+ * are then read with fixed-size loads and masks instead of a branch per byte. Each group is exactly two edges.
+ * 
+ * Edges are read with a neighbour iterator that decodes one group at a time, so traversals use getEdges(v) exactly as 
+ * they do with CsrGraph. Assumes a little-endian machine.
+*/
+
+class CompressedGraph {
+private:
+    uint32_t _vertexCount;
+    uint64_t _adjacencyCount;
+    GraphType _type;
+    std::vector<uint64_t> _offsets;   // Start of each vertex's stream in _bytes.
+    std::vector<uint64_t> _inOffsets; // Reverse streams, for directed graphs only.
+    std::vector<uint8_t> _bytes;      // Padded so a group can always be read with 4 byte loads.
+    TagArena _tags;
+
+    /**
+     * @brief Appends one vertex's sorted, encoded adjacency list to _bytes.
+     */
+    void encodeList(uint32_t vertex, std::vector<CompactEdge>& list);
+
+public:
+    /**
+     * @brief Decodes one adjacency list, yielding CompactEdge values in increasing target order.
+     */
+    class EdgeRange {
+    private:
+        const uint8_t* _stream;
+        uint32_t _vertex;
+        uint32_t _count;
+
+    public:
+        class Iterator {
+        private:
+            const uint8_t* _position;
+            uint32_t _remaining;
+            uint32_t _vertex;
+            uint32_t _values[4];
+            int _valueIndex;
+            CompactEdge _current;
+
+            void decodeGroup() {
+                static const uint32_t MASKS[4] = {0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+                uint8_t control = *_position++;
+                for (int i = 0; i < 4; i++) {
+                    uint32_t lengthCode = (control >> (2 * i)) & 3;
+                    uint32_t word;
+                    std::memcpy(&word, _position, sizeof(word));
+                    _values[i] = word & MASKS[lengthCode];
+                    _position += lengthCode + 1;
+                }
+                _valueIndex = 0;
+            }
+
+            void decodeEdge(bool first) {
+                if (_valueIndex == 4)
+                    decodeGroup();
+                uint32_t gap = _values[_valueIndex];
+                uint32_t weight = _values[_valueIndex + 1];
+                _valueIndex += 2;
+                _current.target = first ? _vertex + (uint32_t)unzigzag(gap) : _current.target + gap;
+                _current.weight = unzigzag(weight);
+            }
+
+        public:
+            Iterator(const uint8_t* position, uint32_t remaining, uint32_t vertex) : 
+                    _position(position), _remaining(remaining), _vertex(vertex), _valueIndex(4) {
+                if (_remaining > 0)
+                    decodeEdge(true);
+            }
+
+            CompactEdge operator*() const {
+                return _current;
+            }
+
+            Iterator& operator++() {
+                if (--_remaining > 0)
+                    decodeEdge(false);
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return _remaining != other._remaining;
+            }
+        };
+
+        EdgeRange(const uint8_t* stream, uint32_t vertex) : _vertex(vertex) {
+            _stream = decodeVarint(stream, _count);
+        }
+
+        Iterator begin() const {
+            return Iterator(_stream, _count, _vertex);
+        }
+
+        Iterator end() const {
+            return Iterator(nullptr, 0, _vertex);
+        }
+
+        uint64_t size() const {
+            return _count;
+        }
+    };
+
+    /**
+     * @brief Compresses a CSR graph, keeping its ids, tags and type.
+     * 
+     * @param graph the graph to compress
+     */
+    explicit CompressedGraph(const CsrGraph& graph);
+
+    /**
+     * @brief Compresses a compact graph, keeping its ids, tags and type.
+     * 
+     * @param graph the graph to compress
+     */
+    explicit CompressedGraph(const CompactGraph& graph);
+
+    ~CompressedGraph() = default;
+
+    /**
+     * @brief Returns the edges leaving a vertex, sorted by target.
+     */
+    EdgeRange getEdges(uint32_t vertex) const {
+        return EdgeRange(_bytes.data() + _offsets[vertex], vertex);
+    }
+
+    /**
+     * @brief Returns the edges arriving at a vertex, where each edge's target is the vertex it comes from. For an 
+     * undirected graph this is the same as getEdges().
+     */
+    EdgeRange getInEdges(uint32_t vertex) const {
+        return EdgeRange(_bytes.data() + ((_type == GraphType::directed) ? _inOffsets : _offsets)[vertex], vertex);
+    }
+
+    uint32_t indexOfTag(std::string_view tag) const;
+    std::string_view getTag(uint32_t vertex) const;
+    GraphType getType() const;
+    uint32_t vertexCount() const;
+    uint64_t adjacencyCount() const;
+    uint64_t edgeCount() const;
+
+    /**
+     * @brief Returns how many bytes the adjacency streams and their offsets take, not counting tags.
+     * 
+     * @return size_t memory used by the edges
+     */
+    size_t byteSize() const;
+
+    /**
+     * @brief Zigzag encoding maps signed values to unsigned ones so that small magnitudes stay small: 0, -1, 1, -2, 
+     * ... become 0, 1, 2, 3, ...
+     */
+    static uint32_t zigzag(int32_t value) {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+
+    static int32_t unzigzag(uint32_t value) {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+
+    /**
+     * @brief Reads a LEB128 varint (7 bits per byte, high bit set on all but the last byte).
+     * 
+     * @return const uint8_t* the first byte after the varint
+     */
+    static const uint8_t* decodeVarint(const uint8_t* position, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; ; shift += 7) {
+            uint8_t byte = *position++;
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return position;
+        }
+    }
+};
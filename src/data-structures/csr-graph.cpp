@@ -0,0 +1,243 @@
+#include "csr-graph.h"
+#include <stdexcept>
+#include <utility>
+
+void CsrGraph::pointAtOwnedStorage() {
+    _offsets = _ownedOffsets.data();
+    _targets = _ownedTargets.data();
+    _weights = (_stride == 1) ? _ownedWeights.data() : reinterpret_cast<const int32_t*>(_ownedTargets.data() + 1);
+    _tagOffsets = _ownedTags.getOffsets().data();
+    _tagCharacters = _ownedTags.getCharacters().data();
+    if (_type == GraphType::directed) {
+        _inStride = 1;
+        _inOffsets = _ownedInOffsets.data();
+        _inSources = _ownedInSources.data();
+        _inWeights = _ownedInWeights.data();
+    } else {
+        _inStride = _stride;
+        _inOffsets = _offsets;
+        _inSources = _targets;
+        _inWeights = _weights;
+    }
+}
+
+void CsrGraph::allocate(uint32_t vertexCount, uint64_t adjacencyCount, CsrLayout layout, GraphType type) {
+    _vertexCount = vertexCount;
+    _adjacencyCount = adjacencyCount;
+    _stride = (layout == CsrLayout::structureOfArrays) ? 1 : 2;
+    _type = type;
+    _ownedOffsets.assign((size_t)vertexCount + 1, 0);
+    if (_stride == 1) {
+        _ownedTargets.assign(adjacencyCount, 0);
+        _ownedWeights.assign(adjacencyCount, 0);
+    } else {
+        _ownedTargets.assign(adjacencyCount * 2, 0);
+    }
+    if (type == GraphType::directed) {
+        _ownedInOffsets.assign((size_t)vertexCount + 1, 0);
+        _ownedInSources.assign(adjacencyCount, 0);
+        _ownedInWeights.assign(adjacencyCount, 0);
+    }
+    pointAtOwnedStorage();
+}
+
+void CsrGraph::setAdjacency(uint64_t index, uint32_t target, int32_t weight) {
+    // AoS: [target, weight, target, weight, ...].
+    if (_stride == 1) {
+        _ownedTargets[index] = target;
+        _ownedWeights[index] = weight;
+    } else {
+        _ownedTargets[index * 2] = target;
+        _ownedTargets[index * 2 + 1] = (uint32_t)weight;
+    }
+}
+
+CsrGraph::CsrGraph(const Graph& graph, CsrLayout layout) {
+    const std::vector<Vertex>& vertices = graph.getVertices();
+    const std::vector<std::vector<Edge>>& edges = graph.getEdges();
+    for (int i = 0; i < vertices.size(); i++) {
+        if (_ownedTags.intern(vertices[i].tag) != i)
+            throw std::invalid_argument("Graph has two vertices with the same tag.");
+    }
+
+    uint64_t adjacencyCount = 0;
+    for (int i = 0; i < edges.size(); i++)
+        adjacencyCount += edges[i].size();
+    allocate(vertices.size(), adjacencyCount, layout, graph.getType());
+
+    uint64_t next = 0;
+    for (int i = 0; i < vertices.size(); i++) {
+        _ownedOffsets[i] = next;
+        for (int j = 0; j < edges[i].size(); j++) {
+            const Edge& edge = edges[i][j];
+            const Vertex& adjacentVertex = (*edge.vertexA == vertices[i]) ? *edge.vertexB : *edge.vertexA;
+            setAdjacency(next++, _ownedTags.find(adjacentVertex.tag), edge.weight);
+        }
+    }
+    _ownedOffsets[_vertexCount] = next;
+
+    if (_type == GraphType::directed) {
+        const std::vector<std::vector<Edge>>& inEdges = graph.getInEdges();
+        next = 0;
+        for (int i = 0; i < vertices.size(); i++) {
+            _ownedInOffsets[i] = next;
+            for (int j = 0; j < inEdges[i].size(); j++) {
+                _ownedInSources[next] = _ownedTags.find(inEdges[i][j].vertexA->tag);
+                _ownedInWeights[next++] = inEdges[i][j].weight;
+            }
+        }
+        _ownedInOffsets[_vertexCount] = next;
+    }
+}
+
+CsrGraph::CsrGraph(const CompactGraph& graph, CsrLayout layout) {
+    // Removed vertices keep their ids but lose their tags, so that indexOfTag cannot find them.
+    bool anyRemoved = false;
+    for (uint32_t i = 0; i < graph.vertexCount() && !anyRemoved; i++)
+        anyRemoved = graph.isRemoved(i);
+    if (anyRemoved) {
+        _ownedTags.reserve(graph.vertexCount(), graph.getTags().getCharacters().size());
+        for (uint32_t i = 0; i < graph.vertexCount(); i++) {
+            if (graph.isRemoved(i))
+                _ownedTags.addBlank();
+            else
+                _ownedTags.intern(graph.getTag(i));
+        }
+    } else {
+        _ownedTags = graph.getTags();
+    }
+
+    uint64_t adjacencyCount = 0;
+    for (uint32_t i = 0; i < graph.vertexCount(); i++)
+        adjacencyCount += graph.getEdges(i).size();
+    allocate(graph.vertexCount(), adjacencyCount, layout, graph.getType());
+
+    uint64_t next = 0;
+    for (uint32_t i = 0; i < _vertexCount; i++) {
+        _ownedOffsets[i] = next;
+        for (CompactEdge edge : graph.getEdges(i))
+            setAdjacency(next++, edge.target, edge.weight);
+    }
+    _ownedOffsets[_vertexCount] = next;
+
+    if (_type == GraphType::directed) {
+        next = 0;
+        for (uint32_t i = 0; i < _vertexCount; i++) {
+            _ownedInOffsets[i] = next;
+            for (CompactEdge edge : graph.getInEdges(i)) {
+                _ownedInSources[next] = edge.target;
+                _ownedInWeights[next++] = edge.weight;
+            }
+        }
+        _ownedInOffsets[_vertexCount] = next;
+    }
+}
+
+CsrGraph::CsrGraph(std::vector<uint64_t>&& offsets, std::vector<uint32_t>&& targets, std::vector<int32_t>&& weights, 
+        TagArena&& tags) {
+    _vertexCount = offsets.size() - 1;
+    _adjacencyCount = targets.size();
+    _stride = 1;
+    _type = GraphType::undirected;
+    _ownedOffsets = std::move(offsets);
+    _ownedTargets = std::move(targets);
+    _ownedWeights = std::move(weights);
+    _ownedTags = std::move(tags);
+    pointAtOwnedStorage();
+}
+
+CsrGraph::CsrGraph(std::vector<uint64_t>&& offsets, std::vector<uint32_t>&& targets, std::vector<int32_t>&& weights, 
+        std::vector<uint64_t>&& inOffsets, std::vector<uint32_t>&& inSources, std::vector<int32_t>&& inWeights, 
+        TagArena&& tags) : CsrGraph(std::move(offsets), std::move(targets), std::move(weights), std::move(tags)) {
+    _type = GraphType::directed;
+    _ownedInOffsets = std::move(inOffsets);
+    _ownedInSources = std::move(inSources);
+    _ownedInWeights = std::move(inWeights);
+    pointAtOwnedStorage();
+}
+
+CsrGraph::CsrGraph(uint32_t vertexCount, uint64_t adjacencyCount, const uint64_t* offsets, const uint32_t* targets, 
+        const int32_t* weights, const uint32_t* tagOffsets, const char* tagCharacters, const uint64_t* inOffsets, 
+        const uint32_t* inSources, const int32_t* inWeights) {
+    _vertexCount = vertexCount;
+    _adjacencyCount = adjacencyCount;
+    _stride = 1;
+    _offsets = offsets;
+    _targets = targets;
+    _weights = weights;
+    _tagOffsets = tagOffsets;
+    _tagCharacters = tagCharacters;
+    _type = (inOffsets != nullptr) ? GraphType::directed : GraphType::undirected;
+    _inStride = 1;
+    _inOffsets = (inOffsets != nullptr) ? inOffsets : offsets;
+    _inSources = (inOffsets != nullptr) ? inSources : targets;
+    _inWeights = (inOffsets != nullptr) ? inWeights : weights;
+}
+
+CsrGraph::CsrGraph(CsrGraph&& other) {
+    *this = std::move(other);
+}
+
+CsrGraph& CsrGraph::operator=(CsrGraph&& other) {
+    _vertexCount = other._vertexCount;
+    _adjacencyCount = other._adjacencyCount;
+    _stride = other._stride;
+    _offsets = other._offsets;
+    _targets = other._targets;
+    _weights = other._weights;
+    _tagOffsets = other._tagOffsets;
+    _tagCharacters = other._tagCharacters;
+    _type = other._type;
+    _inStride = other._inStride;
+    _inOffsets = other._inOffsets;
+    _inSources = other._inSources;
+    _inWeights = other._inWeights;
+    _ownedOffsets = std::move(other._ownedOffsets);
+    _ownedTargets = std::move(other._ownedTargets);
+    _ownedWeights = std::move(other._ownedWeights);
+    _ownedInOffsets = std::move(other._ownedInOffsets);
+    _ownedInSources = std::move(other._ownedInSources);
+    _ownedInWeights = std::move(other._ownedInWeights);
+    _ownedTags = std::move(other._ownedTags);
+
+    // Short tag strings live inside the std::string object itself, so owned pointers must be refreshed after a move.
+    if (!_ownedOffsets.empty())
+        pointAtOwnedStorage();
+    return *this;
+}
+
+uint32_t CsrGraph::indexOfTag(std::string_view tag) const {
+    if (!_ownedOffsets.empty())
+        return _ownedTags.find(tag);
+
+    // Views have no hash table, so fall back to a scan.
+    for (uint32_t i = 0; i < _vertexCount; i++) {
+        if (getTag(i) == tag)
+            return i;
+    }
+    return CompactGraph::NO_VERTEX;
+}
+
+std::string_view CsrGraph::getTag(uint32_t vertex) const {
+    return std::string_view(_tagCharacters + _tagOffsets[vertex], _tagOffsets[vertex + 1] - _tagOffsets[vertex]);
+}
+
+CsrLayout CsrGraph::getLayout() const {
+    return (_stride == 1) ? CsrLayout::structureOfArrays : CsrLayout::arrayOfStructures;
+}
+
+GraphType CsrGraph::getType() const {
+    return _type;
+}
+
+uint32_t CsrGraph::vertexCount() const {
+    return _vertexCount;
+}
+
+uint64_t CsrGraph::adjacencyCount() const {
+    return _adjacencyCount;
+}
+
+uint64_t CsrGraph::edgeCount() const {
+    return (_type == GraphType::directed) ? _adjacencyCount : _adjacencyCount / 2;
+}
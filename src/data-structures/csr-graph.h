@@ -0,0 +1,273 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "graph.h"
+#include "compact-graph.h"
+#include "tag-arena.h"
+
+/*
+ * An immutable compressed sparse row (CSR) snapshot of a graph. The adjacency list of vertex v is entries 
+ * offsets[v] .. offsets[v + 1] of one contiguous targets array and one contiguous weights array, so a traversal 
+ * streams through memory instead of jumping between one heap allocation per vertex.
+ * 
+ * A directed graph also keeps a reverse CSR (always structure of arrays) of the edges arriving at each vertex, so 
+ * algorithms can either push along out-edges or pull along in-edges. For an undirected graph the two are the same.
+ * 
+ * The arrays are read through raw pointers so that a CsrGraph can also be a view over memory it does not own. When 
+ * built from a Graph or CompactGraph it owns its storage, and moving it is cheap.
+*/
+
+/**
+ * @brief How targets and weights are laid out. Structure of arrays keeps all targets together, which is best for 
+ * traversals that ignore weights. Array of structures keeps each target next to its weight.
+ */
+enum CsrLayout {structureOfArrays, arrayOfStructures};
+
+class CsrGraph {
+private:
+    uint32_t _vertexCount;
+    uint64_t _adjacencyCount;
+    uint32_t _stride; // Distance between consecutive targets (and weights): 1 for SoA, 2 for AoS.
+    const uint64_t* _offsets;
+    const uint32_t* _targets;
+    const int32_t* _weights;
+    const uint32_t* _tagOffsets;
+    const char* _tagCharacters;
+    GraphType _type;
+    uint32_t _inStride;
+    const uint64_t* _inOffsets;
+    const uint32_t* _inSources;
+    const int32_t* _inWeights;
+
+    // Owned storage. Empty when the graph is a view over external memory.
+    std::vector<uint64_t> _ownedOffsets;
+    std::vector<uint32_t> _ownedTargets; // In AoS layout this holds targets and weights interleaved.
+    std::vector<int32_t> _ownedWeights;  // Empty in AoS layout.
+    std::vector<uint64_t> _ownedInOffsets; // The reverse CSR. Empty for undirected graphs.
+    std::vector<uint32_t> _ownedInSources;
+    std::vector<int32_t> _ownedInWeights;
+    TagArena _ownedTags;
+
+    /**
+     * @brief Points the raw array pointers at the owned storage.
+     */
+    void pointAtOwnedStorage();
+
+    /**
+     * @brief Allocates owned storage for a known number of vertices and adjacencies. Offsets must be filled in after.
+     */
+    void allocate(uint32_t vertexCount, uint64_t adjacencyCount, CsrLayout layout, GraphType type);
+
+    /**
+     * @brief Writes one adjacency into owned storage.
+     */
+    void setAdjacency(uint64_t index, uint32_t target, int32_t weight);
+
+public:
+    /**
+     * @brief The edges leaving one vertex. Iterating yields CompactEdge values.
+     */
+    class EdgeRange {
+    private:
+        const uint32_t* _targets;
+        const int32_t* _weights;
+        uint32_t _stride;
+        uint64_t _count;
+
+    public:
+        class Iterator {
+        private:
+            const uint32_t* _target;
+            const int32_t* _weight;
+            uint32_t _stride;
+
+        public:
+            Iterator(const uint32_t* target, const int32_t* weight, uint32_t stride) : 
+                    _target(target), _weight(weight), _stride(stride) { }
+
+            CompactEdge operator*() const {
+                return {*_target, *_weight};
+            }
+
+            Iterator& operator++() {
+                _target += _stride;
+                _weight += _stride;
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return _target != other._target;
+            }
+        };
+
+        EdgeRange(const uint32_t* targets, const int32_t* weights, uint32_t stride, uint64_t count) : 
+                _targets(targets), _weights(weights), _stride(stride), _count(count) { }
+
+        Iterator begin() const {
+            return Iterator(_targets, _weights, _stride);
+        }
+
+        Iterator end() const {
+            return Iterator(_targets + _count * _stride, _weights + _count * _stride, _stride);
+        }
+
+        uint64_t size() const {
+            return _count;
+        }
+
+        CompactEdge operator[](uint64_t index) const {
+            return {_targets[index * _stride], _weights[index * _stride]};
+        }
+    };
+
+    /**
+     * @brief Builds a snapshot of a graph in one pass over its adjacency lists. Vertex ids follow the order of 
+     * graph.getVertices(). Throws std::invalid_argument if two vertices share a tag, since edges are matched to 
+     * vertices by tag.
+     * 
+     * @param graph the graph to snapshot, directed or not
+     * @param layout how targets and weights are laid out
+     */
+    explicit CsrGraph(const Graph& graph, CsrLayout layout = CsrLayout::structureOfArrays);
+
+    /**
+     * @brief Builds a snapshot of a compact graph in one pass over its adjacency lists. Vertex ids are unchanged; 
+     * removed vertices keep their ids but get an empty tag that indexOfTag does not find.
+     * 
+     * @param graph the graph to snapshot, directed or not
+     * @param layout how targets and weights are laid out
+     */
+    explicit CsrGraph(const CompactGraph& graph, CsrLayout layout = CsrLayout::structureOfArrays);
+
+    /**
+     * @brief Takes ownership of already built CSR arrays in structure-of-arrays layout, without copying them.
+     * 
+     * @param offsets vertexCount + 1 adjacency list offsets
+     * @param targets adjacency targets
+     * @param weights adjacency weights, one per target
+     * @param tags vertex tags, where tag i belongs to vertex i
+     */
+    CsrGraph(std::vector<uint64_t>&& offsets, std::vector<uint32_t>&& targets, std::vector<int32_t>&& weights, 
+            TagArena&& tags);
+
+    /**
+     * @brief Takes ownership of already built CSR arrays of a directed graph, forward and reverse, without copying 
+     * them.
+     */
+    CsrGraph(std::vector<uint64_t>&& offsets, std::vector<uint32_t>&& targets, std::vector<int32_t>&& weights, 
+            std::vector<uint64_t>&& inOffsets, std::vector<uint32_t>&& inSources, std::vector<int32_t>&& inWeights, 
+            TagArena&& tags);
+
+    /**
+     * @brief Creates a read-only view over arrays owned by someone else, e.g. a memory-mapped file. Targets and 
+     * weights must be in structure-of-arrays layout, and every array must outlive the view.
+     * 
+     * @param vertexCount how many vertices there are
+     * @param adjacencyCount how many entries targets and weights each have
+     * @param offsets vertexCount + 1 adjacency list offsets
+     * @param targets adjacency targets
+     * @param weights adjacency weights
+     * @param tagOffsets vertexCount + 1 offsets into tagCharacters
+     * @param tagCharacters every tag, back to back
+     * @param inOffsets vertexCount + 1 reverse adjacency list offsets for a directed graph, or nullptr if undirected
+     * @param inSources reverse adjacency sources, or nullptr if undirected
+     * @param inWeights reverse adjacency weights, or nullptr if undirected
+     */
+    CsrGraph(uint32_t vertexCount, uint64_t adjacencyCount, const uint64_t* offsets, const uint32_t* targets, 
+            const int32_t* weights, const uint32_t* tagOffsets, const char* tagCharacters, 
+            const uint64_t* inOffsets = nullptr, const uint32_t* inSources = nullptr, 
+            const int32_t* inWeights = nullptr);
+
+    CsrGraph(const CsrGraph& other) = delete;
+    CsrGraph& operator=(const CsrGraph& other) = delete;
+    CsrGraph(CsrGraph&& other);
+    CsrGraph& operator=(CsrGraph&& other);
+    ~CsrGraph() = default;
+
+    /**
+     * @brief Returns the id of the vertex with the given tag.
+     * 
+     * @param tag the vertex's tag
+     * @return uint32_t the vertex's id, or CompactGraph::NO_VERTEX if there is no such vertex
+     */
+    uint32_t indexOfTag(std::string_view tag) const;
+
+    std::string_view getTag(uint32_t vertex) const;
+
+    /**
+     * @brief Returns the edges leaving a vertex.
+     * 
+     * @param vertex the vertex's id
+     * @return EdgeRange the vertex's adjacency list
+     */
+    EdgeRange getEdges(uint32_t vertex) const {
+        uint64_t begin = _offsets[vertex];
+        return EdgeRange(_targets + begin * _stride, _weights + begin * _stride, _stride, 
+                _offsets[vertex + 1] - begin);
+    }
+
+    /**
+     * @brief Returns the edges arriving at a vertex, where each edge's target is the vertex it comes from. For an 
+     * undirected graph this is the same as getEdges().
+     * 
+     * @param vertex the vertex's id
+     * @return EdgeRange the vertex's reverse adjacency list
+     */
+    EdgeRange getInEdges(uint32_t vertex) const {
+        uint64_t begin = _inOffsets[vertex];
+        return EdgeRange(_inSources + begin * _inStride, _inWeights + begin * _inStride, _inStride, 
+                _inOffsets[vertex + 1] - begin);
+    }
+
+    /**
+     * @brief Returns where a vertex's reverse adjacency list starts. See getOffset().
+     */
+    uint64_t getInOffset(uint32_t vertex) const {
+        return _inOffsets[vertex];
+    }
+
+    uint32_t getInSource(uint64_t adjacency) const {
+        return _inSources[adjacency * _inStride];
+    }
+
+    int32_t getInWeight(uint64_t adjacency) const {
+        return _inWeights[adjacency * _inStride];
+    }
+
+    /**
+     * @brief Returns where a vertex's adjacency list starts. Adjacencies of vertex v are getOffset(v) .. 
+     * getOffset(v + 1).
+     * 
+     * @param vertex the vertex's id, or vertexCount() for the end of the last list
+     * @return uint64_t index of the vertex's first adjacency
+     */
+    uint64_t getOffset(uint32_t vertex) const {
+        return _offsets[vertex];
+    }
+
+    /**
+     * @brief Returns the tag table. Tag v is getTagCharacters()[getTagOffsets()[v] .. getTagOffsets()[v + 1]).
+     */
+    const uint32_t* getTagOffsets() const {
+        return _tagOffsets;
+    }
+
+    const char* getTagCharacters() const {
+        return _tagCharacters;
+    }
+
+    uint32_t getTarget(uint64_t adjacency) const {
+        return _targets[adjacency * _stride];
+    }
+
+    int32_t getWeight(uint64_t adjacency) const {
+        return _weights[adjacency * _stride];
+    }
+
+    CsrLayout getLayout() const;
+    GraphType getType() const;
+    uint32_t vertexCount() const;
+    uint64_t adjacencyCount() const;
+    uint64_t edgeCount() const;
+};
@@ -0,0 +1,105 @@
+#include "disjoint-set.h"
+#include <utility>
+
+DisjointSet::DisjointSet(uint32_t count) : _parents(count), _sizes(count, 1), _setCount(count) {
+    for (uint32_t i = 0; i < count; i++)
+        _parents[i] = i;
+}
+
+uint32_t DisjointSet::find(uint32_t element) {
+    while (_parents[element] != element) {
+        _parents[element] = _parents[_parents[element]];
+        element = _parents[element];
+    }
+    return element;
+}
+
+bool DisjointSet::unite(uint32_t elementA, uint32_t elementB) {
+    uint32_t rootA = find(elementA);
+    uint32_t rootB = find(elementB);
+    if (rootA == rootB)
+        return false;
+
+    if (_sizes[rootA] < _sizes[rootB])
+        std::swap(rootA, rootB);
+    _parents[rootB] = rootA;
+    _sizes[rootA] += _sizes[rootB];
+    _setCount--;
+    return true;
+}
+
+bool DisjointSet::connected(uint32_t elementA, uint32_t elementB) {
+    return find(elementA) == find(elementB);
+}
+
+uint32_t DisjointSet::setSize(uint32_t element) {
+    return _sizes[find(element)];
+}
+
+uint32_t DisjointSet::setCount() const {
+    return _setCount;
+}
+
+uint32_t DisjointSet::elementCount() const {
+    return _parents.size();
+}
+
+ConcurrentDisjointSet::ConcurrentDisjointSet(uint32_t count) : _parents(count), _setCount(count) {
+    for (uint32_t i = 0; i < count; i++)
+        _parents[i].store(i, std::memory_order_relaxed);
+}
+
+uint32_t ConcurrentDisjointSet::find(uint32_t element) {
+    while (true) {
+        uint32_t parent = _parents[element].load(std::memory_order_acquire);
+        if (parent == element)
+            return element;
+        uint32_t grandparent = _parents[parent].load(std::memory_order_acquire);
+        if (grandparent == parent)
+            return parent;
+
+        // The swap works on a copy so that a failure, which only means another thread already moved element up, 
+        // leaves parent and grandparent as they were read. Either way the walk goes on from the grandparent.
+        uint32_t expected = parent;
+        _parents[element].compare_exchange_weak(expected, grandparent, std::memory_order_release, 
+            std::memory_order_relaxed);
+        element = grandparent;
+    }
+}
+
+bool ConcurrentDisjointSet::unite(uint32_t elementA, uint32_t elementB) {
+    while (true) {
+        uint32_t rootA = find(elementA);
+        uint32_t rootB = find(elementB);
+        if (rootA == rootB)
+            return false;
+
+        if (rootA > rootB)
+            std::swap(rootA, rootB);
+        uint32_t expected = rootA;
+        if (_parents[rootA].compare_exchange_strong(expected, rootB, std::memory_order_acq_rel)) {
+            _setCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+bool ConcurrentDisjointSet::connected(uint32_t elementA, uint32_t elementB) {
+    while (true) {
+        uint32_t rootA = find(elementA);
+        uint32_t rootB = find(elementB);
+        if (rootA == rootB)
+            return true;
+        // rootA may have been linked under another root since it was found; if not, the sets really are apart.
+        if (_parents[rootA].load(std::memory_order_acquire) == rootA)
+            return false;
+    }
+}
+
+uint32_t ConcurrentDisjointSet::setCount() const {
+    return _setCount.load(std::memory_order_relaxed);
+}
+
+uint32_t ConcurrentDisjointSet::elementCount() const {
+    return _parents.size();
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Partitions the elements 0, 1, ..., count - 1 into disjoint sets, starting with every element on its own. 
+ * Each set is a tree stored as one parent per element in a flat array; the root names the set.
+ * 
+ * Union by size keeps the trees shallow, and find() halves the path it walks (every element it passes is pointed at 
+ * its grandparent), so a sequence of operations costs nearly constant time each.
+ */
+class DisjointSet {
+private:
+    std::vector<uint32_t> _parents;
+    std::vector<uint32_t> _sizes; // Only meaningful for roots.
+    uint32_t _setCount;
+
+public:
+    /**
+     * @brief Creates count singleton sets.
+     * 
+     * @param count how many elements there are
+     */
+    explicit DisjointSet(uint32_t count);
+    ~DisjointSet() = default;
+
+    /**
+     * @brief Returns the root of the set an element is in.
+     * 
+     * @param element an element
+     * @return uint32_t the root of its set
+     */
+    uint32_t find(uint32_t element);
+
+    /**
+     * @brief Merges the sets of two elements, hanging the smaller tree under the root of the larger one.
+     * 
+     * @param elementA an element
+     * @param elementB another element
+     * @return bool true if they were in different sets, false if there was nothing to merge
+     */
+    bool unite(uint32_t elementA, uint32_t elementB);
+
+    /**
+     * @brief Returns whether two elements are in the same set.
+     */
+    bool connected(uint32_t elementA, uint32_t elementB);
+
+    /**
+     * @brief Returns how many elements are in the set an element is in.
+     */
+    uint32_t setSize(uint32_t element);
+
+    /**
+     * @brief Returns how many disjoint sets there are.
+     */
+    uint32_t setCount() const;
+
+    /**
+     * @brief Returns how many elements there are.
+     */
+    uint32_t elementCount() const;
+};
+
+/**
+ * @brief A disjoint set that any number of threads can find, unite and query at the same time, without locks.
+ * 
+ * Parents are atomics. A union links the root with the smaller id under the root with the larger one with a single 
+ * compare-and-swap, which fails only if another thread changed that root first, in which case it finds the roots 
+ * again and retries; linking by id can never make a cycle. find() halves paths with compare-and-swap too, skipping 
+ * an update if another thread got there first, since any ancestor is still a correct parent.
+ * 
+ * Without union by size the trees rely on path halving alone to stay shallow, which works well when ids are not 
+ * correlated with the order of unions.
+ */
+class ConcurrentDisjointSet {
+private:
+    std::vector<std::atomic<uint32_t>> _parents;
+    std::atomic<uint32_t> _setCount;
+
+public:
+    /**
+     * @brief Creates count singleton sets.
+     * 
+     * @param count how many elements there are
+     */
+    explicit ConcurrentDisjointSet(uint32_t count);
+    ~ConcurrentDisjointSet() = default;
+
+    /**
+     * @brief Returns the root of the set an element is in. With unions running at the same time the root may be 
+     * linked under another one right after it is returned.
+     * 
+     * @param element an element
+     * @return uint32_t the root of its set
+     */
+    uint32_t find(uint32_t element);
+
+    /**
+     * @brief Merges the sets of two elements.
+     * 
+     * @param elementA an element
+     * @param elementB another element
+     * @return bool true if this call merged two sets, false if they were already one
+     */
+    bool unite(uint32_t elementA, uint32_t elementB);
+
+    /**
+     * @brief Returns whether two elements are in the same set. Exact once every union that started before it has 
+     * returned.
+     */
+    bool connected(uint32_t elementA, uint32_t elementB);
+
+    /**
+     * @brief Returns how many disjoint sets there are.
+     */
+    uint32_t setCount() const;
+
+    /**
+     * @brief Returns how many elements there are.
+     */
+    uint32_t elementCount() const;
+};
@@ -0,0 +1,227 @@
+#include "edge-list-loader.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "mapped-file.h"
+#include "parallel.h"
+
+/**
+ * @brief The edges parsed from one chunk of the file. Endpoints start out as ids into the chunk's own tags and are 
+ * rewritten to global ids once every chunk's tags have been merged.
+ */
+struct EdgeListChunk {
+    const char* begin;
+    const char* end;
+    TagArena tags;
+    std::vector<uint32_t> vertexA;
+    std::vector<uint32_t> vertexB;
+    std::vector<int32_t> weights;
+    const char* error = nullptr; // Start of the first malformed line, if any.
+};
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p))
+        p++;
+    return p;
+}
+
+const char* skipToken(const char* p, const char* end) {
+    while (p < end && !isBlank(*p) && *p != '\n')
+        p++;
+    return p;
+}
+
+void parseChunk(EdgeListChunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    while (p < end) {
+        const char* line = p;
+        p = skipBlanks(p, end);
+        if (p == end)
+            break;
+        if (*p == '\n' || *p == '#') {
+            while (p < end && *p != '\n')
+                p++;
+            if (p < end)
+                p++;
+            continue;
+        }
+
+        const char* tagA = p;
+        p = skipToken(p, end);
+        std::string_view a(tagA, p - tagA);
+        p = skipBlanks(p, end);
+        const char* tagB = p;
+        p = skipToken(p, end);
+        std::string_view b(tagB, p - tagB);
+        p = skipBlanks(p, end);
+
+        // std::from_chars does not look at the locale and does not allocate.
+        int32_t weight;
+        std::from_chars_result parsed = std::from_chars(p, end, weight);
+        p = skipBlanks(parsed.ptr, end);
+        if (a.empty() || b.empty() || parsed.ec != std::errc() || (p < end && *p != '\n')) {
+            chunk.error = line;
+            return;
+        }
+        if (p < end)
+            p++;
+
+        chunk.vertexA.push_back(chunk.tags.intern(a));
+        chunk.vertexB.push_back(chunk.tags.intern(b));
+        chunk.weights.push_back(weight);
+    }
+}
+
+/**
+ * @brief Turns per-vertex counts into CSR offsets, and resets each counter to its vertex's first slot.
+ */
+std::vector<uint64_t> claimOffsets(std::atomic<uint64_t>* cursors, uint32_t n) {
+    std::vector<uint64_t> offsets((size_t)n + 1);
+    offsets[0] = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        offsets[i + 1] = offsets[i] + cursors[i].load(std::memory_order_relaxed);
+        cursors[i].store(offsets[i], std::memory_order_relaxed);
+    }
+    return offsets;
+}
+
+/**
+ * @brief Sorts every adjacency list by target, then weight. Threads claim slots in no particular order, so this is 
+ * what makes the result independent of the thread count.
+ */
+void sortAdjacencyLists(const std::vector<uint64_t>& offsets, std::vector<uint32_t>& targets, 
+        std::vector<int32_t>& weights, unsigned int threadCount) {
+    parallelFor(offsets.size() - 1, threadCount, [&](size_t begin, size_t end, unsigned int) {
+        std::vector<CompactEdge> list;
+        for (size_t v = begin; v < end; v++) {
+            list.clear();
+            for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++)
+                list.push_back({targets[i], weights[i]});
+            std::sort(list.begin(), list.end(), [](const CompactEdge& x, const CompactEdge& y) {
+                return (x.target != y.target) ? x.target < y.target : x.weight < y.weight;
+            });
+            for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+                targets[i] = list[i - offsets[v]].target;
+                weights[i] = list[i - offsets[v]].weight;
+            }
+        }
+    });
+}
+
+CsrGraph loadEdgeList(const std::string& path, unsigned int threadCount, GraphType type) {
+    MappedFile file(path);
+    const char* data = file.getData();
+    const size_t size = file.getSize();
+    threadCount = resolveThreadCount(threadCount);
+
+    // Split the file into one chunk per thread, moving each boundary to just past the next newline.
+    std::vector<EdgeListChunk> chunks(threadCount);
+    const char* boundary = data;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        chunks[t].begin = boundary;
+        const char* target = data + size * (t + 1) / threadCount;
+        boundary = std::max(boundary, target);
+        while (boundary < data + size && boundary != data && boundary[-1] != '\n')
+            boundary++;
+        chunks[t].end = boundary;
+    }
+
+    // Parse and intern locally, in parallel.
+    parallelFor(threadCount, threadCount, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; t++)
+            parseChunk(chunks[t]);
+    });
+    for (unsigned int t = 0; t < threadCount; t++) {
+        if (chunks[t].error != nullptr)
+            throw std::runtime_error("Malformed edge at byte " + std::to_string(chunks[t].error - data) + " of " + 
+                    path + ".");
+    }
+
+    // Merge the per-chunk tags in file order so ids follow first appearance, then translate endpoints to global ids.
+    TagArena tags;
+    std::vector<std::vector<uint32_t>> globalIds(threadCount);
+    for (unsigned int t = 0; t < threadCount; t++) {
+        const TagArena& local = chunks[t].tags;
+        globalIds[t].resize(local.size());
+        for (uint32_t i = 0; i < local.size(); i++)
+            globalIds[t][i] = tags.intern(local.get(i));
+        chunks[t].tags = TagArena(); // No longer needed.
+    }
+    const uint32_t n = tags.size();
+
+    // Count: the degree of every vertex. A self-loop is one adjacency, as in CompactGraph::addEdge(). A directed edge 
+    // counts towards its source's out-degree and its destination's in-degree.
+    const bool directed = type == GraphType::directed;
+    std::unique_ptr<std::atomic<uint64_t>[]> cursors(new std::atomic<uint64_t>[n]());
+    std::unique_ptr<std::atomic<uint64_t>[]> inCursors(directed ? new std::atomic<uint64_t>[n]() : nullptr);
+    parallelFor(threadCount, threadCount, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; t++) {
+            EdgeListChunk& chunk = chunks[t];
+            for (size_t i = 0; i < chunk.weights.size(); i++) {
+                uint32_t a = globalIds[t][chunk.vertexA[i]];
+                uint32_t b = globalIds[t][chunk.vertexB[i]];
+                chunk.vertexA[i] = a;
+                chunk.vertexB[i] = b;
+                cursors[a].fetch_add(1, std::memory_order_relaxed);
+                if (directed)
+                    inCursors[b].fetch_add(1, std::memory_order_relaxed);
+                else if (b != a)
+                    cursors[b].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    std::vector<uint64_t> offsets = claimOffsets(cursors.get(), n);
+    std::vector<uint32_t> targets(offsets[n]);
+    std::vector<int32_t> weights(offsets[n]);
+    std::vector<uint64_t> inOffsets;
+    std::vector<uint32_t> inSources;
+    std::vector<int32_t> inWeights;
+    if (directed) {
+        inOffsets = claimOffsets(inCursors.get(), n);
+        inSources.resize(inOffsets[n]);
+        inWeights.resize(inOffsets[n]);
+    }
+
+    // Fill: every adjacency claims the next free slot in its vertex's list.
+    parallelFor(threadCount, threadCount, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; t++) {
+            EdgeListChunk& chunk = chunks[t];
+            for (size_t i = 0; i < chunk.weights.size(); i++) {
+                uint32_t a = chunk.vertexA[i];
+                uint32_t b = chunk.vertexB[i];
+                uint64_t slot = cursors[a].fetch_add(1, std::memory_order_relaxed);
+                targets[slot] = b;
+                weights[slot] = chunk.weights[i];
+                if (directed) {
+                    slot = inCursors[b].fetch_add(1, std::memory_order_relaxed);
+                    inSources[slot] = a;
+                    inWeights[slot] = chunk.weights[i];
+                } else if (b != a) {
+                    slot = cursors[b].fetch_add(1, std::memory_order_relaxed);
+                    targets[slot] = a;
+                    weights[slot] = chunk.weights[i];
+                }
+            }
+            chunk = EdgeListChunk();
+        }
+    });
+    cursors.reset();
+    inCursors.reset();
+
+    sortAdjacencyLists(offsets, targets, weights, threadCount);
+    if (!directed)
+        return CsrGraph(std::move(offsets), std::move(targets), std::move(weights), std::move(tags));
+
+    sortAdjacencyLists(inOffsets, inSources, inWeights, threadCount);
+    return CsrGraph(std::move(offsets), std::move(targets), std::move(weights), std::move(inOffsets), 
+            std::move(inSources), std::move(inWeights), std::move(tags));
+}
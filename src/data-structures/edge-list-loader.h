@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include "csr-graph.h"
+
+/**
+ * @brief Loads a graph from a text edge list, one "tagA tagB weight" edge per line. In a directed graph each edge goes 
+ * from tagA to tagB. Tags are any run of non-whitespace characters and weights are decimal int32 values. Blank lines 
+ * and lines starting with '#' are skipped.
+ * 
+ * The file is memory-mapped and split at newline boundaries into one chunk per thread. Each thread parses its chunk 
+ * and interns the tags it sees into its own TagArena; the per-thread arenas are then merged, which only costs one 
+ * lookup per distinct tag per thread. The CSR arrays are built with a count-then-fill pass, and every adjacency list 
+ * is sorted by target so the result does not depend on the thread count.
+ * 
+ * Vertex ids follow the order in which tags first appear in the file.
+ * 
+ * Throws std::runtime_error if the file cannot be read or a line is malformed.
+ * 
+ * @param path the edge list file
+ * @param threadCount how many threads to use, or 0 to use every hardware thread
+ * @param type whether the edges are undirected or directed
+ * @return CsrGraph the loaded graph
+ */
+CsrGraph loadEdgeList(const std::string& path, unsigned int threadCount = 0, GraphType type = GraphType::undirected);
@@ -0,0 +1,155 @@
+#include "graph-file.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+uint64_t alignTo8(uint64_t position) {
+    return (position + 7) & ~(uint64_t)7;
+}
+
+/**
+ * @brief Returns whether a section of size bytes at position lies inside a file of length bytes and starts on an 
+ * 8-byte boundary, without overflowing on hostile header values.
+ */
+bool isValidSection(uint64_t position, uint64_t size, uint64_t length) {
+    return position % 8 == 0 && size <= length && position <= length - size;
+}
+
+void writeSection(std::ofstream& file, const void* data, uint64_t size, uint64_t position) {
+    // Zero padding up to the section's aligned start.
+    const char zeros[8] = {};
+    uint64_t current = file.tellp();
+    file.write(zeros, position - current);
+    file.write(static_cast<const char*>(data), size);
+}
+
+void writeGraphFile(const CsrGraph& graph, const std::string& path) {
+    const uint32_t n = graph.vertexCount();
+    const uint64_t m = graph.adjacencyCount();
+
+    // Gather targets and weights into SoA form, whatever the source layout is.
+    std::vector<uint64_t> offsets(n + 1);
+    std::vector<uint32_t> targets(m);
+    std::vector<int32_t> weights(m);
+    for (uint32_t i = 0; i <= n; i++)
+        offsets[i] = graph.getOffset(i);
+    for (uint64_t i = 0; i < m; i++) {
+        targets[i] = graph.getTarget(i);
+        weights[i] = graph.getWeight(i);
+    }
+    const uint32_t* tagOffsets = graph.getTagOffsets();
+    const bool directed = graph.getType() == GraphType::directed;
+    std::vector<uint64_t> inOffsets;
+    std::vector<uint32_t> inSources;
+    std::vector<int32_t> inWeights;
+    if (directed) {
+        inOffsets.resize(n + 1);
+        inSources.resize(m);
+        inWeights.resize(m);
+        for (uint32_t i = 0; i <= n; i++)
+            inOffsets[i] = graph.getInOffset(i);
+        for (uint64_t i = 0; i < m; i++) {
+            inSources[i] = graph.getInSource(i);
+            inWeights[i] = graph.getInWeight(i);
+        }
+    }
+
+    GraphFileHeader header = {};
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.vertexCount = n;
+    header.adjacencyCount = m;
+    header.tagCharacterCount = tagOffsets[n];
+    header.offsetsPosition = alignTo8(sizeof(GraphFileHeader));
+    header.targetsPosition = alignTo8(header.offsetsPosition + (n + 1) * sizeof(uint64_t));
+    header.weightsPosition = alignTo8(header.targetsPosition + m * sizeof(uint32_t));
+    header.tagOffsetsPosition = alignTo8(header.weightsPosition + m * sizeof(int32_t));
+    header.tagCharactersPosition = alignTo8(header.tagOffsetsPosition + (n + 1) * sizeof(uint32_t));
+    if (directed) {
+        header.flags = GRAPH_FILE_DIRECTED;
+        header.inOffsetsPosition = alignTo8(header.tagCharactersPosition + header.tagCharacterCount);
+        header.inSourcesPosition = alignTo8(header.inOffsetsPosition + (n + 1) * sizeof(uint64_t));
+        header.inWeightsPosition = alignTo8(header.inSourcesPosition + m * sizeof(uint32_t));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(file, offsets.data(), (n + 1) * sizeof(uint64_t), header.offsetsPosition);
+    writeSection(file, targets.data(), m * sizeof(uint32_t), header.targetsPosition);
+    writeSection(file, weights.data(), m * sizeof(int32_t), header.weightsPosition);
+    writeSection(file, tagOffsets, (n + 1) * sizeof(uint32_t), header.tagOffsetsPosition);
+    writeSection(file, graph.getTagCharacters(), header.tagCharacterCount, header.tagCharactersPosition);
+    if (directed) {
+        writeSection(file, inOffsets.data(), (n + 1) * sizeof(uint64_t), header.inOffsetsPosition);
+        writeSection(file, inSources.data(), m * sizeof(uint32_t), header.inSourcesPosition);
+        writeSection(file, inWeights.data(), m * sizeof(int32_t), header.inWeightsPosition);
+    }
+    if (!file)
+        throw std::runtime_error("Could not write " + path + ".");
+}
+
+void writeGraphFile(const Graph& graph, const std::string& path) {
+    writeGraphFile(CsrGraph(graph), path);
+}
+
+MappedGraph::MappedGraph(const std::string& path) : _file(path) {
+    _graph = nullptr;
+    const size_t length = _file.getSize();
+
+    // Validate the header and that every section lies inside the file before handing out any pointers.
+    const char* base = _file.getData();
+    const GraphFileHeader* header = reinterpret_cast<const GraphFileHeader*>(base);
+    bool valid = length >= GRAPH_FILE_HEADER_SIZE_V1 
+            && std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) == 0 
+            && header->version >= 1 && header->version <= GRAPH_FILE_VERSION 
+            && (header->version == 1 || length >= sizeof(GraphFileHeader));
+    if (!valid)
+        throw std::runtime_error(path + " is not a supported graph file.");
+
+    const uint64_t n = header->vertexCount;
+    const uint64_t m = header->adjacencyCount;
+    const bool directed = header->version >= 2 && (header->flags & GRAPH_FILE_DIRECTED) != 0;
+    // With n and m bounded, none of the section sizes below can overflow.
+    valid = n <= UINT32_MAX && m <= length 
+            && isValidSection(header->offsetsPosition, (n + 1) * sizeof(uint64_t), length) 
+            && isValidSection(header->targetsPosition, m * sizeof(uint32_t), length) 
+            && isValidSection(header->weightsPosition, m * sizeof(int32_t), length) 
+            && isValidSection(header->tagOffsetsPosition, (n + 1) * sizeof(uint32_t), length) 
+            && isValidSection(header->tagCharactersPosition, header->tagCharacterCount, length);
+    if (directed) {
+        valid = valid 
+                && isValidSection(header->inOffsetsPosition, (n + 1) * sizeof(uint64_t), length) 
+                && isValidSection(header->inSourcesPosition, m * sizeof(uint32_t), length) 
+                && isValidSection(header->inWeightsPosition, m * sizeof(int32_t), length);
+    }
+
+    // The arrays themselves are trusted; checking every offset would fault in the whole file. Only the ends are checked.
+    valid = valid 
+            && reinterpret_cast<const uint64_t*>(base + header->offsetsPosition)[n] == m 
+            && reinterpret_cast<const uint32_t*>(base + header->tagOffsetsPosition)[n] == header->tagCharacterCount 
+            && (!directed || reinterpret_cast<const uint64_t*>(base + header->inOffsetsPosition)[n] == m);
+    if (!valid)
+        throw std::runtime_error(path + " is not a supported graph file.");
+
+    _graph = new CsrGraph(header->vertexCount, header->adjacencyCount, 
+            reinterpret_cast<const uint64_t*>(base + header->offsetsPosition), 
+            reinterpret_cast<const uint32_t*>(base + header->targetsPosition), 
+            reinterpret_cast<const int32_t*>(base + header->weightsPosition), 
+            reinterpret_cast<const uint32_t*>(base + header->tagOffsetsPosition), 
+            base + header->tagCharactersPosition, 
+            directed ? reinterpret_cast<const uint64_t*>(base + header->inOffsetsPosition) : nullptr, 
+            directed ? reinterpret_cast<const uint32_t*>(base + header->inSourcesPosition) : nullptr, 
+            directed ? reinterpret_cast<const int32_t*>(base + header->inWeightsPosition) : nullptr);
+}
+
+MappedGraph::~MappedGraph() {
+    delete _graph;
+}
+
+const CsrGraph& MappedGraph::getGraph() const {
+    return *_graph;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "graph.h"
+#include "csr-graph.h"
+#include "mapped-file.h"
+
+/*
+ * A versioned binary file format for graphs, laid out so that it can be memory-mapped and used directly as a CsrGraph 
+ * without parsing or copying anything. Pages are only read from disk when a traversal first touches them, so opening 
+ * a graph takes the same time no matter how large it is.
+ * 
+ * Layout (native byte order, every section starts on an 8 byte boundary):
+ *     GraphFileHeader
+ *     uint64_t offsets[vertexCount + 1]
+ *     uint32_t targets[adjacencyCount]
+ *     int32_t  weights[adjacencyCount]
+ *     uint32_t tagOffsets[vertexCount + 1]
+ *     char     tagCharacters[tagCharacterCount]
+ *     uint64_t inOffsets[vertexCount + 1]   (directed graphs only, version 2+)
+ *     uint32_t inSources[adjacencyCount]    (directed graphs only, version 2+)
+ *     int32_t  inWeights[adjacencyCount]    (directed graphs only, version 2+)
+ * 
+ * Version 1 headers end at tagCharactersPosition and always describe undirected graphs. They can still be opened.
+*/
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexCount;
+    uint64_t adjacencyCount;
+    uint64_t tagCharacterCount;
+    uint64_t offsetsPosition;
+    uint64_t targetsPosition;
+    uint64_t weightsPosition;
+    uint64_t tagOffsetsPosition;
+    uint64_t tagCharactersPosition;
+
+    // Version 2.
+    uint64_t flags;
+    uint64_t inOffsetsPosition;
+    uint64_t inSourcesPosition;
+    uint64_t inWeightsPosition;
+};
+
+constexpr char GRAPH_FILE_MAGIC[8] = {'D', 'S', 'A', 'G', 'R', 'A', 'P', 'H'};
+constexpr uint32_t GRAPH_FILE_VERSION = 2;
+constexpr size_t GRAPH_FILE_HEADER_SIZE_V1 = offsetof(GraphFileHeader, flags);
+constexpr uint64_t GRAPH_FILE_DIRECTED = 1; // Flag: the graph is directed and has reverse CSR sections.
+
+/**
+ * @brief Writes a graph to a file in the binary graph format.
+ * 
+ * @param graph the graph to write
+ * @param path where to write it
+ */
+void writeGraphFile(const CsrGraph& graph, const std::string& path);
+
+/**
+ * @brief Writes a graph to a file in the binary graph format.
+ * 
+ * @param graph the graph to write
+ * @param path where to write it
+ */
+void writeGraphFile(const Graph& graph, const std::string& path);
+
+/**
+ * @brief A read-only graph backed by a memory-mapped binary graph file. The file stays mapped for as long as the 
+ * object lives.
+ */
+class MappedGraph {
+private:
+    MappedFile _file;
+    CsrGraph* _graph;
+
+public:
+    /**
+     * @brief Maps a binary graph file. Throws std::runtime_error if the file cannot be opened or is not a valid graph 
+     * file of a supported version.
+     * 
+     * @param path the file to map
+     */
+    explicit MappedGraph(const std::string& path);
+
+    MappedGraph(const MappedGraph& other) = delete;
+    MappedGraph& operator=(const MappedGraph& other) = delete;
+
+    /**
+     * @brief Unmaps the file. The view returned by getGraph() must not be used afterwards.
+     */
+    ~MappedGraph();
+
+    /**
+     * @brief Returns a zero-copy view of the mapped graph.
+     * 
+     * @return const CsrGraph& the graph
+     */
+    const CsrGraph& getGraph() const;
+};
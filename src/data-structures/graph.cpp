@@ -1,7 +1,10 @@
 #include "graph.h"
 
-Graph::Graph() {
+Graph::Graph() : Graph(GraphType::undirected) { }
+
+Graph::Graph(GraphType type) {
     _adjacencies = 0;
+    _type = type;
 }
 
 int Graph::indexOfVertex(const Vertex& vertex) const {
@@ -20,20 +23,42 @@ const std::vector<std::vector<Edge>>& Graph::getEdges() const {
     return _edges;
 }
 
+const std::vector<std::vector<Edge>>& Graph::getInEdges() const {
+    return (_type == GraphType::directed) ? _inEdges : _edges;
+}
+
+GraphType Graph::getType() const {
+    return _type;
+}
+
 int Graph::vertexCount() const {
     return _vertices.size();
 }
 
 int Graph::edgeCount() const {
-    return _adjacencies / 2;
+    return (_type == GraphType::directed) ? _adjacencies : _adjacencies / 2;
 }
 
 void Graph::addVertex(const Vertex& vertex) {
     _vertices.emplace_back(vertex);
     _edges.emplace_back(std::vector<Edge>());
+    if (_type == GraphType::directed)
+        _inEdges.emplace_back(std::vector<Edge>());
 }
 
 void Graph::addEdge(const Edge& edge) {
+    // Directed: the edge leaves vertexA and arrives at vertexB.
+    if (_type == GraphType::directed) {
+        int vertexAIndex = indexOfVertex(*edge.vertexA);
+        int vertexBIndex = indexOfVertex(*edge.vertexB);
+        if (vertexAIndex != -1 && vertexBIndex != -1) {
+            _edges[vertexAIndex].emplace_back(edge);
+            _inEdges[vertexBIndex].emplace_back(edge);
+            _adjacencies++;
+        }
+        return;
+    }
+
     for (int i = 0; i < _vertices.size(); i++) {
         if (_vertices[i] == *edge.vertexA || _vertices[i] == *edge.vertexB) {
             _edges[i].emplace_back(edge);
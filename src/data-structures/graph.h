@@ -3,10 +3,15 @@
 #include <vector>
 
 /*
- * Note: it is impossible to create a generic graph covering all situations. This is a very basic, weighted, undirected 
- * graph for the purposes of playing around with some graph algorithms.
+ * Note: it is impossible to create a generic graph covering all situations. This is a very basic, weighted graph for 
+ * the purposes of playing around with some graph algorithms. It is undirected unless constructed as directed.
 */
 
+/**
+ * @brief Whether an edge can be travelled both ways (undirected) or only from vertexA to vertexB (directed).
+ */
+enum GraphType {undirected, directed};
+
 struct Vertex {
     std::string tag;
 
@@ -41,10 +46,13 @@ class Graph {
 private:
     std::vector<Vertex> _vertices;
     std::vector<std::vector<Edge>> _edges;
+    std::vector<std::vector<Edge>> _inEdges; // Only used by directed graphs.
     int _adjacencies;
+    GraphType _type;
 
 public:
     Graph();
+    explicit Graph(GraphType type);
     ~Graph() = default;
 
     int indexOfVertex(const Vertex& vertex) const;
@@ -52,6 +60,14 @@ public:
     const std::vector<Vertex>& getVertices() const;
     const std::vector<std::vector<Edge>>& getEdges() const;
 
+    /**
+     * @brief Returns, for every vertex, the edges that arrive at it. For an undirected graph this is the same as 
+     * getEdges().
+     */
+    const std::vector<std::vector<Edge>>& getInEdges() const;
+
+    GraphType getType() const;
+
     int vertexCount() const;
     int edgeCount() const;
 
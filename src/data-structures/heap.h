@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 
 enum HeapType {max, min};
 
 /**
- * @brief Represents a binary min or max heap.
+ * @brief Represents a binary min or max heap over a caller-owned array, as used by heapSort. For a queue that owns and 
+ * grows its storage, see PriorityQueue.
  * 
  * @tparam T the type of data to store in the heap
  */
@@ -64,9 +66,7 @@ private:
         int parentIndex = index;
         int childIndex = comparisonChildIndex(parentIndex);
         while (outOfOrder(parentIndex, childIndex)) {
-            T temp = _source[parentIndex];
-            _source[parentIndex] = _source[childIndex];
-            _source[childIndex] = temp;
+            std::swap(_source[parentIndex], _source[childIndex]);
 
             parentIndex = childIndex;
             childIndex = comparisonChildIndex(parentIndex);
@@ -82,9 +82,7 @@ private:
         int childIndex = index;
         int parentIndex = (index - 1) / 2;
         while (childIndex != 0 && outOfOrder(parentIndex, childIndex)) {
-            T temp = _source[parentIndex];
-            _source[parentIndex] = _source[childIndex];
-            _source[childIndex] = temp;
+            std::swap(_source[parentIndex], _source[childIndex]);
 
             childIndex = parentIndex;
             parentIndex = (childIndex - 1) / 2;
@@ -157,8 +155,8 @@ public:
      * @return T the min or max element, based on the heap's type
      */
     T extractMinMax() {
-        T minMax = _source[0];
-        _source[0] = _source[_count - 1];
+        T minMax = std::move(_source[0]);
+        _source[0] = std::move(_source[_count - 1]);
         _count--;
         siftDown(0);
         return minMax;
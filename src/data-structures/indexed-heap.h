@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Represents a d-ary min heap of integer ids in [0, capacity), each with a key. Knows where every id sits, so a
+ * key can be lowered in place with decreaseKey instead of inserting the id again.
+ *
+ * @tparam K the type of key; compared with <
+ * @tparam Arity how many children each node has; 4 keeps the heap shallow and each node's children on one cache line
+ */
+template <typename K, unsigned int Arity = 4>
+class IndexedHeap {
+private:
+    constexpr static uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+    struct Node {
+        K key;
+        uint32_t id;
+    };
+
+    std::vector<Node> _nodes;          // In heap order, so a node's key is next to its id.
+    std::vector<uint32_t> _positions;  // Position of each id in _nodes, or NOT_IN_HEAP.
+
+    /**
+     * @brief Moves a node up until its parent's key is not greater, filling the hole as it goes.
+     *
+     * @param index position of the node
+     */
+    void siftUp(size_t index) {
+        Node node = _nodes[index];
+        while (index > 0) {
+            size_t parentIndex = (index - 1) / Arity;
+            if (!(node.key < _nodes[parentIndex].key))
+                break;
+            _nodes[index] = _nodes[parentIndex];
+            _positions[_nodes[index].id] = index;
+            index = parentIndex;
+        }
+        _nodes[index] = node;
+        _positions[node.id] = index;
+    }
+
+    /**
+     * @brief Moves a node down until none of its children has a smaller key, filling the hole as it goes.
+     *
+     * @param index position of the node
+     */
+    void siftDown(size_t index) {
+        Node node = _nodes[index];
+        const size_t count = _nodes.size();
+        while (true) {
+            size_t firstChild = index * Arity + 1;
+            if (firstChild >= count)
+                break;
+            size_t lastChild = (firstChild + Arity < count) ? firstChild + Arity : count;
+            size_t smallest = firstChild;
+            for (size_t child = firstChild + 1; child < lastChild; child++) {
+                if (_nodes[child].key < _nodes[smallest].key)
+                    smallest = child;
+            }
+            if (!(_nodes[smallest].key < node.key))
+                break;
+            _nodes[index] = _nodes[smallest];
+            _positions[_nodes[index].id] = index;
+            index = smallest;
+        }
+        _nodes[index] = node;
+        _positions[node.id] = index;
+    }
+public:
+    /**
+     * @brief Constructs an empty heap for ids in [0, capacity).
+     *
+     * @param capacity one more than the largest id that will be inserted
+     */
+    explicit IndexedHeap(size_t capacity = 0) : _positions(capacity, NOT_IN_HEAP) {
+        _nodes.reserve(capacity);
+    }
+
+    /**
+     * @brief Returns how many ids are stored in the heap. Not to be confused with capacity.
+     *
+     * @return size_t how many ids are stored in the heap
+     */
+    size_t getCount() const {
+        return _nodes.size();
+    }
+
+    /**
+     * @brief Returns one more than the largest id the heap accepts.
+     *
+     * @return size_t the id capacity
+     */
+    size_t getCapacity() const {
+        return _positions.size();
+    }
+
+    /**
+     * @brief Grows the id range. Never shrinks it, and keeps whatever is in the heap.
+     *
+     * @param capacity one more than the largest id that will be inserted
+     */
+    void reserve(size_t capacity) {
+        if (capacity > _positions.size()) {
+            _positions.resize(capacity, NOT_IN_HEAP);
+            _nodes.reserve(capacity);
+        }
+    }
+
+    /**
+     * @brief Returns whether an id is in the heap.
+     *
+     * @param id the id
+     * @return bool true if the id is in the heap, false otherwise
+     */
+    bool contains(uint32_t id) const {
+        return _positions[id] != NOT_IN_HEAP;
+    }
+
+    /**
+     * @brief Returns the key of an id in the heap.
+     *
+     * @param id an id in the heap
+     * @return const K& its key
+     */
+    const K& getKey(uint32_t id) const {
+        return _nodes[_positions[id]].key;
+    }
+
+    /**
+     * @brief Returns the id with the smallest key. The heap must not be empty.
+     *
+     * @return uint32_t the id with the smallest key
+     */
+    uint32_t getMin() const {
+        return _nodes[0].id;
+    }
+
+    /**
+     * @brief Returns the smallest key. The heap must not be empty.
+     *
+     * @return const K& the smallest key
+     */
+    const K& getMinKey() const {
+        return _nodes[0].key;
+    }
+
+    /**
+     * @brief Returns the id with the smallest key and removes it from the heap. The heap must not be empty.
+     *
+     * @return uint32_t the id with the smallest key
+     */
+    uint32_t extractMin() {
+        uint32_t id = _nodes[0].id;
+        _positions[id] = NOT_IN_HEAP;
+        Node last = _nodes.back();
+        _nodes.pop_back();
+        if (!_nodes.empty()) {
+            _nodes[0] = last;
+            siftDown(0);
+        }
+        return id;
+    }
+
+    /**
+     * @brief Inserts an id that is not in the heap yet.
+     *
+     * @param id the id, less than the capacity
+     * @param key its key
+     */
+    void insert(uint32_t id, const K& key) {
+        _nodes.push_back({key, id});
+        siftUp(_nodes.size() - 1);
+    }
+
+    /**
+     * @brief Lowers the key of an id in the heap. Does nothing if the new key is not smaller.
+     *
+     * @param id an id in the heap
+     * @param key its new key
+     * @return bool true if the key was lowered, false otherwise
+     */
+    bool decreaseKey(uint32_t id, const K& key) {
+        size_t index = _positions[id];
+        if (!(key < _nodes[index].key))
+            return false;
+        _nodes[index].key = key;
+        siftUp(index);
+        return true;
+    }
+
+    /**
+     * @brief Changes the key of an id in the heap, up or down.
+     *
+     * @param id an id in the heap
+     * @param key its new key
+     */
+    void updateKey(uint32_t id, const K& key) {
+        size_t index = _positions[id];
+        bool lower = key < _nodes[index].key;
+        _nodes[index].key = key;
+        if (lower)
+            siftUp(index);
+        else
+            siftDown(index);
+    }
+
+    /**
+     * @brief Inserts an id, or lowers its key if it is already in the heap.
+     *
+     * @param id the id, less than the capacity
+     * @param key its key
+     * @return bool true if the id was inserted or its key lowered, false otherwise
+     */
+    bool insertOrDecrease(uint32_t id, const K& key) {
+        if (!contains(id)) {
+            insert(id, key);
+            return true;
+        }
+        return decreaseKey(id, key);
+    }
+
+    /**
+     * @brief Empties the heap in time proportional to its count, keeping the capacity.
+     */
+    void clear() {
+        for (const Node& node : _nodes)
+            _positions[node.id] = NOT_IN_HEAP;
+        _nodes.clear();
+    }
+};
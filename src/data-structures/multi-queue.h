@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "priority-queue.h"
+
+/**
+ * @brief Represents a relaxed concurrent priority queue (Rihani, Sanders and Dementiev's MultiQueue): any number of
+ * threads can push and extract at the same time, but an extraction only returns an element close to the top, not
+ * necessarily the top itself.
+ *
+ * The queue is c * p sequential PriorityQueues, each behind its own lock, for p threads. A push goes to a random
+ * sub-queue. An extraction looks at the tops of a few random sub-queues and pops the best of them. Locks are only ever
+ * tried, never waited on: a thread that finds a sub-queue busy just picks another, so threads almost never contend.
+ *
+ * The relaxation is configurable. More sub-queues per thread mean fewer collisions and more throughput, but the
+ * elements near the top are spread over more queues, so extractions stray further from the true top. Sampling more
+ * sub-queues per extraction pulls them back towards it at the cost of more locking. With the defaults (2 per thread,
+ * 2 sampled) the expected rank of an extracted element is O(p).
+ *
+ * That makes it suitable for schedulers that tolerate some disorder, such as parallel Dijkstra with re-relaxation or
+ * best-first search, not for anything that needs exact order.
+ *
+ * @tparam T the type of data to store in the queue; must be movable
+ * @tparam Compare callable as compare(a, b), true if a should come out before b
+ */
+template <typename T, typename Compare = std::less<T>>
+class MultiQueue {
+private:
+    /**
+     * @brief One sub-queue, on its own cache lines so that threads working on neighbouring sub-queues do not slow
+     * each other down.
+     */
+    struct alignas(64) SubQueue {
+        std::mutex lock;
+        PriorityQueue<T, Compare> heap;
+    };
+
+    std::unique_ptr<SubQueue[]> _queues;
+    size_t _queueCount;
+    unsigned int _sampleCount;
+    Compare _compare;
+    std::atomic<size_t> _count;
+
+    /**
+     * @brief Returns a random sub-queue index. Each thread has its own generator, so no state is shared.
+     */
+    size_t randomQueue() const {
+        thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return (size_t)((state >> 32) * _queueCount >> 32);
+    }
+
+    /**
+     * @brief Pushes an element onto a random sub-queue that is not locked.
+     */
+    template <typename U>
+    void pushToSome(U&& element) {
+        while (true) {
+            SubQueue& queue = _queues[randomQueue()];
+            if (!queue.lock.try_lock())
+                continue;
+            // Counted before the element can be extracted, so that the count never drops below zero.
+            queue.heap.push(std::forward<U>(element));
+            _count.fetch_add(1, std::memory_order_release);
+            queue.lock.unlock();
+            return;
+        }
+    }
+
+    /**
+     * @brief Pops the best top of every sub-queue that is not empty, locking them all at once. Used when sampling
+     * keeps finding empty sub-queues, so that a few remaining elements are still found.
+     */
+    bool extractFromAll(T& element) {
+        for (size_t i = 0; i < _queueCount; i++)
+            _queues[i].lock.lock();
+        size_t best = _queueCount;
+        for (size_t i = 0; i < _queueCount; i++) {
+            if (!_queues[i].heap.isEmpty()
+                    && (best == _queueCount || _compare(_queues[i].heap.getTop(), _queues[best].heap.getTop())))
+                best = i;
+        }
+        if (best != _queueCount) {
+            element = _queues[best].heap.extractTop();
+            _count.fetch_sub(1, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < _queueCount; i++)
+            _queues[i].lock.unlock();
+        return best != _queueCount;
+    }
+public:
+    /**
+     * @brief Constructs an empty queue.
+     *
+     * @param threadCount how many threads will use the queue (p)
+     * @param queuesPerThread how many sub-queues to make per thread (c); at least 2 keeps contention low
+     * @param sampleCount how many sub-queues each extraction compares the tops of; at least 1
+     * @param compare the comparator to order elements with
+     */
+    explicit MultiQueue(unsigned int threadCount, unsigned int queuesPerThread = 2, unsigned int sampleCount = 2,
+            const Compare& compare = Compare()) : _sampleCount(sampleCount < 1 ? 1 : sampleCount),
+            _compare(compare), _count(0) {
+        _queueCount = (size_t)(threadCount < 1 ? 1 : threadCount) * (queuesPerThread < 1 ? 1 : queuesPerThread);
+        _queues.reset(new SubQueue[_queueCount]);
+        for (size_t i = 0; i < _queueCount; i++)
+            _queues[i].heap = PriorityQueue<T, Compare>(compare);
+    }
+
+    MultiQueue(const MultiQueue& other) = delete;
+    MultiQueue& operator=(const MultiQueue& other) = delete;
+    ~MultiQueue() = default;
+
+    /**
+     * @brief Returns how many elements are stored. Only exact while no other thread is pushing or extracting.
+     *
+     * @return size_t how many elements are stored
+     */
+    size_t getCount() const {
+        return _count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns how many sub-queues there are.
+     */
+    size_t getQueueCount() const {
+        return _queueCount;
+    }
+
+    /**
+     * @brief Inserts a copy of an element.
+     *
+     * @param element the element to put into the queue
+     */
+    void push(const T& element) {
+        pushToSome(element);
+    }
+
+    /**
+     * @brief Inserts an element by moving it.
+     *
+     * @param element the element to put into the queue
+     */
+    void push(T&& element) {
+        pushToSome(std::move(element));
+    }
+
+    /**
+     * @brief Constructs an element from the given arguments and inserts it.
+     *
+     * @param arguments passed to T's constructor
+     */
+    template <typename... Arguments>
+    void emplace(Arguments&&... arguments) {
+        pushToSome(T(std::forward<Arguments>(arguments)...));
+    }
+
+    /**
+     * @brief Removes an element near the top and returns it through element.
+     *
+     * @param element set to the element removed, if there was one
+     * @return bool true if an element was removed, false if the queue was empty when looked at
+     */
+    bool tryExtract(T& element) {
+        // Give up on sampling after a few rounds that found nothing, which happens when the queue is nearly empty.
+        const unsigned int EMPTY_ROUNDS = 4;
+        unsigned int emptyRounds = 0;
+        while (_count.load(std::memory_order_acquire) > 0) {
+            // Lock up to _sampleCount distinct sub-queues that are free right now, keeping the best non-empty one.
+            SubQueue* best = nullptr;
+            for (unsigned int sample = 0; sample < _sampleCount; sample++) {
+                SubQueue& queue = _queues[randomQueue()];
+                if (&queue == best || !queue.lock.try_lock())
+                    continue;
+                if (!queue.heap.isEmpty() && (best == nullptr || _compare(queue.heap.getTop(), best->heap.getTop()))) {
+                    if (best != nullptr)
+                        best->lock.unlock();
+                    best = &queue;
+                } else {
+                    queue.lock.unlock();
+                }
+            }
+
+            if (best != nullptr) {
+                element = best->heap.extractTop();
+                best->lock.unlock();
+                _count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (++emptyRounds >= EMPTY_ROUNDS) {
+                if (extractFromAll(element))
+                    return true;
+                emptyRounds = 0;
+            }
+        }
+        return false;
+    }
+};
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Represents a d-ary heap that owns its storage and grows as needed. The order is fixed at compile time by a
+ * comparator: the top is the element that comes first, so std::less gives a min heap and std::greater a max heap.
+ * Elements are moved rather than copied, so move-only types such as std::unique_ptr work.
+ *
+ * Unlike Heap, which sorts a caller's array in place, this is meant as a queue: emplace and extract in any order.
+ *
+ * @tparam T the type of data to store in the heap
+ * @tparam Compare callable as compare(a, b), true if a must come out before b
+ * @tparam Arity how many children each node has; 4 keeps the heap shallow and a node's children close together
+ */
+template <typename T, typename Compare = std::less<T>, unsigned int Arity = 4>
+class PriorityQueue {
+private:
+    static_assert(Arity >= 2, "A heap needs at least two children per node.");
+
+    std::vector<T> _elements;
+    Compare _compare;
+
+    /**
+     * @brief Moves the element at index up until its parent comes first, shifting the parents it passes down into
+     * the hole.
+     *
+     * @param index index of element
+     */
+    void siftUp(size_t index) {
+        T element = std::move(_elements[index]);
+        while (index > 0) {
+            size_t parentIndex = (index - 1) / Arity;
+            if (!_compare(element, _elements[parentIndex]))
+                break;
+            _elements[index] = std::move(_elements[parentIndex]);
+            index = parentIndex;
+        }
+        _elements[index] = std::move(element);
+    }
+
+    /**
+     * @brief Moves the element at index down until none of its children comes first, shifting the children it
+     * passes up into the hole.
+     *
+     * @param index index of element
+     */
+    void siftDown(size_t index) {
+        const size_t count = _elements.size();
+        T element = std::move(_elements[index]);
+        while (true) {
+            size_t firstChild = index * Arity + 1;
+            if (firstChild >= count)
+                break;
+            size_t lastChild = (firstChild + Arity < count) ? firstChild + Arity : count;
+            size_t first = firstChild;
+            for (size_t child = firstChild + 1; child < lastChild; child++) {
+                if (_compare(_elements[child], _elements[first]))
+                    first = child;
+            }
+            if (!_compare(_elements[first], element))
+                break;
+            _elements[index] = std::move(_elements[first]);
+            index = first;
+        }
+        _elements[index] = std::move(element);
+    }
+
+    /**
+     * @brief Bottom-up heapify of the whole array, O(n).
+     */
+    void heapify() {
+        if (_elements.size() < 2)
+            return;
+        for (size_t i = (_elements.size() - 2) / Arity + 1; i-- > 0; )
+            siftDown(i);
+    }
+public:
+    /**
+     * @brief Constructs an empty heap.
+     *
+     * @param compare the comparator to order elements with
+     */
+    explicit PriorityQueue(const Compare& compare = Compare()) : _compare(compare) {}
+
+    /**
+     * @brief Constructs a heap out of existing elements with a bottom-up heapify, in O(n).
+     *
+     * @param elements the elements; moved into the heap
+     * @param compare the comparator to order elements with
+     */
+    explicit PriorityQueue(std::vector<T>&& elements, const Compare& compare = Compare()) :
+            _elements(std::move(elements)), _compare(compare) {
+        heapify();
+    }
+
+    PriorityQueue(const PriorityQueue& other) = default;
+    PriorityQueue(PriorityQueue&& other) = default;
+    PriorityQueue& operator=(const PriorityQueue& other) = default;
+    PriorityQueue& operator=(PriorityQueue&& other) = default;
+    ~PriorityQueue() = default;
+
+    /**
+     * @brief Returns how many elements are stored in the heap. Not to be confused with capacity.
+     *
+     * @return size_t how many elements are stored in the heap
+     */
+    size_t getCount() const {
+        return _elements.size();
+    }
+
+    /**
+     * @brief Returns how many elements the heap can hold before it has to grow.
+     *
+     * @return size_t how many elements fit in the current storage
+     */
+    size_t getCapacity() const {
+        return _elements.capacity();
+    }
+
+    /**
+     * @brief Returns whether the heap is empty.
+     */
+    bool isEmpty() const {
+        return _elements.empty();
+    }
+
+    /**
+     * @brief Makes room for at least capacity elements, so that pushes up to that count do not allocate.
+     *
+     * @param capacity how many elements to make room for
+     */
+    void reserve(size_t capacity) {
+        _elements.reserve(capacity);
+    }
+
+    /**
+     * @brief Returns the element that comes first. The heap must not be empty.
+     *
+     * @return const T& the top element
+     */
+    const T& getTop() const {
+        return _elements[0];
+    }
+
+    /**
+     * @brief Removes the element that comes first and returns it. The heap must not be empty.
+     *
+     * @return T the top element
+     */
+    T extractTop() {
+        T top = std::move(_elements[0]);
+        pop();
+        return top;
+    }
+
+    /**
+     * @brief Removes the element that comes first without returning it. The heap must not be empty.
+     */
+    void pop() {
+        if (_elements.size() > 1)
+            _elements[0] = std::move(_elements.back());
+        _elements.pop_back();
+        if (!_elements.empty())
+            siftDown(0);
+    }
+
+    /**
+     * @brief Inserts a copy of an element.
+     *
+     * @param element the element to put into the heap
+     */
+    void push(const T& element) {
+        _elements.push_back(element);
+        siftUp(_elements.size() - 1);
+    }
+
+    /**
+     * @brief Inserts an element by moving it.
+     *
+     * @param element the element to put into the heap
+     */
+    void push(T&& element) {
+        _elements.push_back(std::move(element));
+        siftUp(_elements.size() - 1);
+    }
+
+    /**
+     * @brief Constructs an element in place from the given arguments and inserts it.
+     *
+     * @param arguments passed to T's constructor
+     */
+    template <typename... Arguments>
+    void emplace(Arguments&&... arguments) {
+        _elements.emplace_back(std::forward<Arguments>(arguments)...);
+        siftUp(_elements.size() - 1);
+    }
+
+    /**
+     * @brief Inserts every element of a range. When the range is large compared to the heap, the whole heap is
+     * rebuilt bottom-up in O(n + k) instead of paying O(log n) per element.
+     *
+     * @param first the start of the range
+     * @param last the end of the range
+     */
+    template <typename Iterator>
+    void pushRange(Iterator first, Iterator last) {
+        const size_t oldCount = _elements.size();
+        _elements.insert(_elements.end(), first, last);
+        const size_t added = _elements.size() - oldCount;
+
+        // Sifting each new element up costs about log n compares; a rebuild costs about Arity per element overall.
+        if (added * 8 >= oldCount) {
+            heapify();
+        } else {
+            for (size_t i = oldCount; i < _elements.size(); i++)
+                siftUp(i);
+        }
+    }
+
+    /**
+     * @brief Moves every element out, in heap order, leaving the heap empty. Together with the heapifying constructor
+     * this lets a caller filter the elements in O(n).
+     *
+     * @return std::vector<T> the elements
+     */
+    std::vector<T> takeElements() {
+        std::vector<T> elements = std::move(_elements);
+        _elements.clear();
+        return elements;
+    }
+
+    /**
+     * @brief Removes every element, keeping the storage.
+     */
+    void clear() {
+        _elements.clear();
+    }
+};
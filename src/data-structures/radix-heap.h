@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Represents a monotone min priority queue for unsigned integer keys, as in Dijkstra's algorithm with
+ * non-negative integer weights: a key pushed must never be smaller than the last key extracted.
+ *
+ * Entries are kept in 33 buckets by the highest bit in which their key differs from the last extracted key; bucket 0
+ * holds keys equal to it. Pushing is O(1). When bucket 0 runs out, the lowest non-empty bucket is emptied into lower
+ * buckets around its minimum, and since every entry can only move down, each is moved at most 32 times overall. That
+ * makes extraction amortized O(log C), where C is the largest difference between a key and the last extracted one
+ * (for Dijkstra, the heaviest edge), with no comparisons between entries at all.
+ *
+ * There is no decreaseKey: push the entry again with the lower key and skip the stale copy when it comes out.
+ *
+ * @tparam V the type of value stored with each key
+ */
+template <typename V>
+class RadixHeap {
+private:
+    constexpr static int BUCKET_COUNT = 33;
+
+    struct Entry {
+        uint32_t key;
+        V value;
+    };
+
+    std::vector<Entry> _buckets[BUCKET_COUNT];
+    uint32_t _last;  // The last key extracted, which every stored key is at least.
+    size_t _count;
+
+    /**
+     * @brief Returns the bucket of a key: 0 if it equals the last key, otherwise one more than the index of the
+     * highest bit in which they differ.
+     */
+    int bucketIndex(uint32_t key) const {
+        return (key == _last) ? 0 : 32 - __builtin_clz(key ^ _last);
+    }
+
+    /**
+     * @brief Makes sure bucket 0 holds the smallest keys. The heap must not be empty.
+     */
+    void pull() {
+        if (!_buckets[0].empty())
+            return;
+
+        int index = 1;
+        while (_buckets[index].empty())
+            index++;
+
+        // Every key in this bucket shares the bits above the differing one with _last, so once _last moves to their
+        // minimum they all land in strictly lower buckets.
+        std::vector<Entry>& bucket = _buckets[index];
+        uint32_t minimum = bucket[0].key;
+        for (const Entry& entry : bucket) {
+            if (entry.key < minimum)
+                minimum = entry.key;
+        }
+        _last = minimum;
+        for (Entry& entry : bucket)
+            _buckets[bucketIndex(entry.key)].push_back(std::move(entry));
+        bucket.clear();
+    }
+public:
+    RadixHeap() : _last(0), _count(0) {}
+
+    ~RadixHeap() = default;
+
+    /**
+     * @brief Returns how many entries are stored in the heap.
+     *
+     * @return size_t how many entries are stored in the heap
+     */
+    size_t getCount() const {
+        return _count;
+    }
+
+    /**
+     * @brief Returns whether the heap is empty.
+     */
+    bool isEmpty() const {
+        return _count == 0;
+    }
+
+    /**
+     * @brief Returns the last key extracted, the smallest key that may still be pushed.
+     *
+     * @return uint32_t the last key extracted, or 0 if none has been
+     */
+    uint32_t getLastKey() const {
+        return _last;
+    }
+
+    /**
+     * @brief Inserts an entry.
+     *
+     * @param key its key; at least getLastKey()
+     * @param value its value
+     */
+    void push(uint32_t key, V value) {
+        _buckets[bucketIndex(key)].push_back({key, std::move(value)});
+        _count++;
+    }
+
+    /**
+     * @brief Returns the smallest key. The heap must not be empty. Not const, since it may move entries between
+     * buckets.
+     *
+     * @return uint32_t the smallest key
+     */
+    uint32_t getMinKey() {
+        pull();
+        return _last;
+    }
+
+    /**
+     * @brief Removes an entry with the smallest key and returns its value. The heap must not be empty. Entries with
+     * equal keys come out in no particular order.
+     *
+     * @return V the value of an entry with the smallest key
+     */
+    V extractMin() {
+        pull();
+        V value = std::move(_buckets[0].back().value);
+        _buckets[0].pop_back();
+        _count--;
+        return value;
+    }
+
+    /**
+     * @brief Removes every entry and resets the last key to 0, keeping the buckets' storage.
+     */
+    void clear() {
+        for (std::vector<Entry>& bucket : _buckets)
+            bucket.clear();
+        _last = 0;
+        _count = 0;
+    }
+};
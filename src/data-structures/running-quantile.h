@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "priority-queue.h"
+
+/**
+ * @brief Tracks one quantile of a stream of values, optionally over a sliding window of the most recent ones.
+ *
+ * The values are split between a max heap holding the lower part and a min heap holding the upper part, sized so
+ * that the quantile is the top of the lower heap. Inserting costs O(log n): the value goes into the heap on its side
+ * and at most one value moves across to restore the sizes.
+ *
+ * Values leave the window in the order they came in, so each is stored with its sequence number and one that has left
+ * is recognised by its number alone. It is dropped when it reaches the top of its heap. Values that never reach the
+ * top are swept out by rebuilding a heap in O(n) once it holds more expired values than live ones, so removals cost
+ * amortized O(log n) and memory stays proportional to the window. The sequence number also orders equal values, so
+ * it is always known which heap an expired value is in.
+ *
+ * The quantile q of n values is the value of rank floor(q * (n - 1)) in sorted order, counting from 0, so 0 is the
+ * minimum, 1 the maximum and 0.5 the lower median. The floor is taken as if q were exactly the decimal it was written
+ * as. No interpolation is done, so T only needs to be ordered by <.
+ *
+ * @tparam T the type of value; compared with <
+ */
+template <typename T>
+class RunningQuantile {
+private:
+    struct Entry {
+        T value;
+        uint64_t sequence;
+
+        bool operator<(const Entry& other) const {
+            if (value < other.value)
+                return true;
+            return !(other.value < value) && sequence < other.sequence;
+        }
+
+        bool operator>(const Entry& other) const {
+            return other < *this;
+        }
+    };
+
+    double _quantile;
+    size_t _window;
+    std::deque<T> _recent;                             // Values in the window, oldest first. Only kept with a window.
+
+    PriorityQueue<Entry, std::greater<Entry>> _lower;  // Max heap: the values up to the quantile.
+    PriorityQueue<Entry, std::less<Entry>> _upper;     // Min heap: the values above it.
+    uint64_t _nextSequence;                            // Sequence number of the next value inserted.
+    uint64_t _oldest;                                  // Values with a lower sequence number have left the window.
+    size_t _lowerCount;                                // Live values in _lower.
+    size_t _upperCount;
+    size_t _lowerGarbage;                              // Expired values still in _lower.
+    size_t _upperGarbage;
+
+    /**
+     * @brief Returns how many values the lower heap should hold for the current count.
+     */
+    size_t lowerTarget() const {
+        size_t count = _lowerCount + _upperCount;
+        if (count == 0)
+            return 0;
+        // A quantile like 0.35 is stored a little below its decimal value, which can put q * (n - 1) just under the
+        // integer it should be (0.35 * 340 gives 118.99...). The product is off by at most a couple of ulps, so
+        // scaling it up by a few more makes the floor exact without moving any position that is really fractional.
+        double position = _quantile * (count - 1) * (1 + 4 * DBL_EPSILON);
+        return std::min((size_t)position, count - 1) + 1;
+    }
+
+    /**
+     * @brief Pops expired values off the top of a heap until its top is live.
+     */
+    template <typename Heap>
+    void prune(Heap& heap, size_t& garbage) {
+        while (garbage > 0 && heap.getTop().sequence < _oldest) {
+            heap.pop();
+            garbage--;
+        }
+    }
+
+    /**
+     * @brief Rebuilds a heap without its expired values once they outnumber the live ones.
+     */
+    template <typename Heap>
+    void sweep(Heap& heap, size_t& garbage, size_t live) {
+        if (garbage <= live)
+            return;
+        std::vector<Entry> entries = heap.takeElements();
+        size_t kept = 0;
+        for (Entry& entry : entries) {
+            if (entry.sequence >= _oldest)
+                entries[kept++] = std::move(entry);
+        }
+        entries.erase(entries.begin() + kept, entries.end());
+        heap = Heap(std::move(entries));
+        garbage = 0;
+    }
+
+    /**
+     * @brief Moves values across until the lower heap holds exactly its target, keeping both tops live.
+     */
+    void rebalance() {
+        prune(_lower, _lowerGarbage);
+        prune(_upper, _upperGarbage);
+        size_t target = lowerTarget();
+        while (_lowerCount > target) {
+            _upper.push(_lower.extractTop());
+            _lowerCount--;
+            _upperCount++;
+            prune(_lower, _lowerGarbage);
+        }
+        while (_lowerCount < target) {
+            _lower.push(_upper.extractTop());
+            _upperCount--;
+            _lowerCount++;
+            prune(_upper, _upperGarbage);
+        }
+    }
+
+    /**
+     * @brief Removes the oldest value that is still tracked.
+     *
+     * @param value that value, which the caller keeps in its window
+     */
+    void expireOldest(const T& value) {
+        // Everything in the lower heap comes before its top and everything in the upper heap after it.
+        Entry oldest{value, _oldest++};
+        if (_lowerCount > 0 && !(_lower.getTop() < oldest)) {
+            _lowerGarbage++;
+            _lowerCount--;
+        } else {
+            _upperGarbage++;
+            _upperCount--;
+        }
+        rebalance();
+        sweep(_lower, _lowerGarbage, _lowerCount);
+        sweep(_upper, _upperGarbage, _upperCount);
+    }
+
+    template <typename>
+    friend class RunningQuantiles;
+public:
+    /**
+     * @brief Constructs an empty tracker. Throws std::invalid_argument if the quantile is not in [0, 1].
+     *
+     * @param quantile which quantile to track, e.g. 0.99 for the 99th percentile
+     * @param window how many of the most recent values to track, or 0 to track every value
+     */
+    explicit RunningQuantile(double quantile, size_t window = 0) : _quantile(quantile), _window(window),
+            _nextSequence(0), _oldest(0), _lowerCount(0), _upperCount(0), _lowerGarbage(0), _upperGarbage(0) {
+        if (!(quantile >= 0.0 && quantile <= 1.0))
+            throw std::invalid_argument("Quantile must be between 0 and 1.");
+    }
+
+    ~RunningQuantile() = default;
+
+    /**
+     * @brief Adds a value. With a window that is full, the oldest value is removed first.
+     *
+     * @param value the value to add
+     */
+    void insert(const T& value) {
+        if (_window > 0) {
+            if (_recent.size() == _window) {
+                expireOldest(_recent.front());
+                _recent.pop_front();
+            }
+            _recent.push_back(value);
+        }
+
+        Entry entry{value, _nextSequence++};
+        if (_lowerCount > 0 && !(_lower.getTop() < entry)) {
+            _lower.push(std::move(entry));
+            _lowerCount++;
+        } else {
+            _upper.push(std::move(entry));
+            _upperCount++;
+        }
+        rebalance();
+    }
+
+    /**
+     * @brief Returns the current quantile. There must be at least one value.
+     *
+     * @return const T& the value at the tracked quantile
+     */
+    const T& get() const {
+        return _lower.getTop().value;
+    }
+
+    /**
+     * @brief Returns how many values are tracked, which with a window is at most the window.
+     */
+    size_t getCount() const {
+        return _lowerCount + _upperCount;
+    }
+
+    double getQuantile() const {
+        return _quantile;
+    }
+
+    size_t getWindow() const {
+        return _window;
+    }
+};
+
+/**
+ * @brief Tracks the median of a stream of values; see RunningQuantile. For an even count this is the lower of the
+ * two middle values.
+ *
+ * @tparam T the type of value; compared with <
+ */
+template <typename T>
+class RunningMedian : public RunningQuantile<T> {
+public:
+    /**
+     * @brief Constructs an empty tracker.
+     *
+     * @param window how many of the most recent values to track, or 0 to track every value
+     */
+    explicit RunningMedian(size_t window = 0) : RunningQuantile<T>(0.5, window) {}
+};
+
+/**
+ * @brief Tracks several quantiles of one stream at once, e.g. the 50th, 90th, 99th and 99.9th percentile of a
+ * latency stream.
+ *
+ * This is k RunningQuantiles side by side, sharing only the window: each quantile has its own pair of heaps holding
+ * every tracked value, so k quantiles take k times the memory of one and an insertion costs O(k log n). A dual heap
+ * can only track one rank; sharing one order structure among all of them, such as an order statistic tree, would
+ * store each value once but make every insertion and query O(log n) pointer chasing instead of a few heap steps. For
+ * the handful of quantiles a latency report needs the heaps are the faster choice.
+ *
+ * @tparam T the type of value; compared with <
+ */
+template <typename T>
+class RunningQuantiles {
+private:
+    std::vector<RunningQuantile<T>> _trackers;
+    size_t _window;
+    std::deque<T> _recent;
+    size_t _count;
+
+public:
+    /**
+     * @brief Constructs empty trackers. Throws std::invalid_argument if a quantile is not in [0, 1].
+     *
+     * @param quantiles which quantiles to track
+     * @param window how many of the most recent values to track, or 0 to track every value
+     */
+    explicit RunningQuantiles(const std::vector<double>& quantiles, size_t window = 0) : _window(window), _count(0) {
+        _trackers.reserve(quantiles.size());
+        for (double quantile : quantiles)
+            _trackers.emplace_back(quantile);
+    }
+
+    ~RunningQuantiles() = default;
+
+    /**
+     * @brief Adds a value. With a window that is full, the oldest value is removed first.
+     *
+     * @param value the value to add
+     */
+    void insert(const T& value) {
+        if (_window > 0) {
+            if (_recent.size() == _window) {
+                for (RunningQuantile<T>& tracker : _trackers)
+                    tracker.expireOldest(_recent.front());
+                _recent.pop_front();
+                _count--;
+            }
+            _recent.push_back(value);
+        }
+        for (RunningQuantile<T>& tracker : _trackers)
+            tracker.insert(value);
+        _count++;
+    }
+
+    /**
+     * @brief Returns one of the quantiles. There must be at least one value.
+     *
+     * @param index the position of the quantile in the list given to the constructor
+     * @return const T& the value at that quantile
+     */
+    const T& get(size_t index) const {
+        return _trackers[index].get();
+    }
+
+    /**
+     * @brief Returns every quantile, in the order given to the constructor. There must be at least one value.
+     *
+     * @return std::vector<T> the value at each quantile
+     */
+    std::vector<T> getAll() const {
+        std::vector<T> values;
+        values.reserve(_trackers.size());
+        for (const RunningQuantile<T>& tracker : _trackers)
+            values.push_back(tracker.get());
+        return values;
+    }
+
+    /**
+     * @brief Returns how many values are tracked, which with a window is at most the window.
+     */
+    size_t getCount() const {
+        return _count;
+    }
+
+    size_t getQuantileCount() const {
+        return _trackers.size();
+    }
+};
@@ -0,0 +1,72 @@
+#include "tag-arena.h"
+#include <functional>
+
+TagArena::TagArena() {
+    _offsets.emplace_back(0);
+    _slots.assign(16, EMPTY_SLOT);
+}
+
+size_t TagArena::findSlot(std::string_view tag) const {
+    // Linear probing. The table is never more than half full, so an empty slot always ends the search.
+    size_t mask = _slots.size() - 1;
+    size_t slot = std::hash<std::string_view>()(tag) & mask;
+    while (_slots[slot] != EMPTY_SLOT && get(_slots[slot]) != tag)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+void TagArena::growSlots() {
+    std::vector<uint32_t> oldSlots(_slots.size() * 2, EMPTY_SLOT);
+    oldSlots.swap(_slots);
+    for (int i = 0; i < oldSlots.size(); i++) {
+        if (oldSlots[i] != EMPTY_SLOT)
+            _slots[findSlot(get(oldSlots[i]))] = oldSlots[i];
+    }
+}
+
+uint32_t TagArena::intern(std::string_view tag) {
+    size_t slot = findSlot(tag);
+    if (_slots[slot] != EMPTY_SLOT)
+        return _slots[slot];
+
+    uint32_t id = size();
+    _characters.append(tag.data(), tag.size());
+    _offsets.emplace_back(_characters.size());
+    _slots[slot] = id;
+    if ((size_t)size() * 2 > _slots.size())
+        growSlots();
+    return id;
+}
+
+uint32_t TagArena::addBlank() {
+    _offsets.emplace_back(_characters.size());
+    return size() - 1;
+}
+
+uint32_t TagArena::find(std::string_view tag) const {
+    uint32_t id = _slots[findSlot(tag)];
+    return (id == EMPTY_SLOT) ? NOT_FOUND : id;
+}
+
+std::string_view TagArena::get(uint32_t id) const {
+    return std::string_view(_characters.data() + _offsets[id], _offsets[id + 1] - _offsets[id]);
+}
+
+uint32_t TagArena::size() const {
+    return _offsets.size() - 1;
+}
+
+void TagArena::reserve(uint32_t tagCount, size_t characterCount) {
+    _characters.reserve(characterCount);
+    _offsets.reserve((size_t)tagCount + 1);
+    while (_slots.size() < (size_t)tagCount * 2)
+        growSlots();
+}
+
+const std::string& TagArena::getCharacters() const {
+    return _characters;
+}
+
+const std::vector<uint32_t>& TagArena::getOffsets() const {
+    return _offsets;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Interns vertex tags into one contiguous block of characters. Every distinct tag is stored exactly once and 
+ * is identified by a dense integer id (0, 1, 2, ...) in the order it was first interned.
+ * 
+ * Lookups by tag use an open-addressing hash table of ids, so no second copy of the tag is ever stored.
+ */
+class TagArena {
+private:
+    std::string _characters;
+    std::vector<uint32_t> _offsets; // Tag i is _characters[_offsets[i] .. _offsets[i + 1]).
+    std::vector<uint32_t> _slots;   // Hash table of ids. EMPTY_SLOT marks an unused slot.
+
+    constexpr static uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    /**
+     * @brief Returns the slot that either holds the id of a tag or is the empty slot where it would be inserted.
+     * 
+     * @param tag the tag to look for
+     * @return size_t index into _slots
+     */
+    size_t findSlot(std::string_view tag) const;
+
+    /**
+     * @brief Doubles the hash table and reinserts every id.
+     */
+    void growSlots();
+
+public:
+    constexpr static uint32_t NOT_FOUND = UINT32_MAX;
+
+    TagArena();
+    ~TagArena() = default;
+
+    /**
+     * @brief Returns the id of a tag, interning it first if it has not been seen before.
+     * 
+     * @param tag the tag to intern
+     * @return uint32_t the tag's id
+     */
+    uint32_t intern(std::string_view tag);
+
+    /**
+     * @brief Appends an empty tag under the next id without making it findable, so that ids stay dense when a slot 
+     * has no tag, such as a removed vertex.
+     * 
+     * @return uint32_t the new id
+     */
+    uint32_t addBlank();
+
+    /**
+     * @brief Returns the id of a tag without interning it.
+     * 
+     * @param tag the tag to look for
+     * @return uint32_t the tag's id, or NOT_FOUND if it has not been interned
+     */
+    uint32_t find(std::string_view tag) const;
+
+    /**
+     * @brief Returns the tag with the given id. The view is invalidated by the next call to intern().
+     * 
+     * @param id a tag id
+     * @return std::string_view the tag
+     */
+    std::string_view get(uint32_t id) const;
+
+    /**
+     * @brief Returns how many distinct tags have been interned.
+     * 
+     * @return uint32_t how many distinct tags have been interned
+     */
+    uint32_t size() const;
+
+    /**
+     * @brief Reserves room for a number of tags and characters so that interning does not reallocate.
+     * 
+     * @param tagCount how many tags are expected
+     * @param characterCount how many characters those tags are expected to take in total
+     */
+    void reserve(uint32_t tagCount, size_t characterCount);
+
+    const std::string& getCharacters() const;
+    const std::vector<uint32_t>& getOffsets() const;
+};
@@ -0,0 +1,53 @@
+#include "versioned-graph.h"
+
+VersionedGraph::VersionedGraph(GraphType type) : _graph(type) {
+    _version = 0;
+    std::atomic_store(&_current, std::shared_ptr<const GraphSnapshot>(new GraphSnapshot{CsrGraph(_graph), 0}));
+}
+
+VersionedGraph::VersionedGraph(const CompactGraph& graph) : _graph(graph) {
+    _version = 0;
+    std::atomic_store(&_current, std::shared_ptr<const GraphSnapshot>(new GraphSnapshot{CsrGraph(_graph), 0}));
+}
+
+std::shared_ptr<const GraphSnapshot> VersionedGraph::acquire() const {
+    return std::atomic_load(&_current);
+}
+
+uint64_t VersionedGraph::publish() {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _version++;
+    std::shared_ptr<const GraphSnapshot> snapshot(new GraphSnapshot{CsrGraph(_graph), _version});
+    std::atomic_store(&_current, snapshot);
+    return _version;
+}
+
+uint32_t VersionedGraph::indexOfTag(std::string_view tag) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    return _graph.indexOfTag(tag);
+}
+
+uint32_t VersionedGraph::addVertex(std::string_view tag) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    return _graph.addVertex(tag);
+}
+
+void VersionedGraph::addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _graph.addEdge(vertexA, vertexB, weight);
+}
+
+bool VersionedGraph::removeEdge(uint32_t vertexA, uint32_t vertexB) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    return _graph.removeEdge(vertexA, vertexB);
+}
+
+bool VersionedGraph::updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    return _graph.updateWeight(vertexA, vertexB, weight);
+}
+
+void VersionedGraph::removeVertex(uint32_t vertex) {
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    _graph.removeVertex(vertex);
+}
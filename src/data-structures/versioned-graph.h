@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include "compact-graph.h"
+#include "csr-graph.h"
+
+/**
+ * @brief An immutable published version of a VersionedGraph.
+ */
+struct GraphSnapshot {
+    CsrGraph graph;
+    uint64_t version;
+};
+
+/**
+ * @brief A graph that one or more writers keep changing while many readers run queries on it, in read-copy-update 
+ * style.
+ * 
+ * Writers change a private CompactGraph (one writer at a time) and call publish() to make their changes visible. 
+ * Publishing builds a CsrGraph snapshot and swaps it in atomically. Readers call acquire() to get the latest snapshot 
+ * and run any CsrGraph algorithm on it; they never wait for a snapshot to be built, and a snapshot never changes while 
+ * it is held. The swap itself is not lock-free: std::atomic_load/std::atomic_store on a shared_ptr take a short 
+ * internal lock in libstdc++. A snapshot is freed when the last reader holding it lets go, which is the epoch in which 
+ * it was visible.
+ * 
+ * Publishing costs O(V + E), so batch changes and publish once per batch.
+ */
+class VersionedGraph {
+private:
+    CompactGraph _graph;
+    std::mutex _writeMutex;
+    std::shared_ptr<const GraphSnapshot> _current; // Only accessed through std::atomic_load/std::atomic_store.
+    uint64_t _version;
+
+public:
+    /**
+     * @brief Creates an empty graph and publishes it as version 0.
+     * 
+     * @param type whether the graph is directed
+     */
+    explicit VersionedGraph(GraphType type = GraphType::undirected);
+
+    /**
+     * @brief Starts from a copy of an existing graph, published as version 0.
+     * 
+     * @param graph the initial graph
+     */
+    explicit VersionedGraph(const CompactGraph& graph);
+
+    VersionedGraph(const VersionedGraph& other) = delete;
+    VersionedGraph& operator=(const VersionedGraph& other) = delete;
+    ~VersionedGraph() = default;
+
+    /**
+     * @brief Returns the latest published snapshot. Safe to call from any thread at any time. It does not wait for 
+     * publish() to rebuild the snapshot, only for the brief lock that guards the pointer swap.
+     * 
+     * @return std::shared_ptr<const GraphSnapshot> the snapshot; keep it for as long as its graph is in use
+     */
+    std::shared_ptr<const GraphSnapshot> acquire() const;
+
+    /**
+     * @brief Makes every change so far visible to readers as a new version.
+     * 
+     * @return uint64_t the new version
+     */
+    uint64_t publish();
+
+    /**
+     * @brief Writer side: see CompactGraph. Changes are not visible to readers until publish() is called.
+     */
+    uint32_t indexOfTag(std::string_view tag);
+    uint32_t addVertex(std::string_view tag);
+    void addEdge(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+    bool removeEdge(uint32_t vertexA, uint32_t vertexB);
+    bool updateWeight(uint32_t vertexA, uint32_t vertexB, int32_t weight);
+    void removeVertex(uint32_t vertex);
+};
@@ -1,4 +1,5 @@
 #include "auxiliary.h"
+#include "parallel.h"
 
 int* randomIntArray(int n, int min, int max) {
     std::random_device randomDevice;
@@ -34,6 +35,17 @@ void printGraph(const Graph& graph) {
     }
 }
 
+void printGraph(const CompactGraph& graph) {
+    for (uint32_t i = 0; i < graph.vertexCount(); i++) {
+        // Vertex.
+        std::cout << graph.getTag(i) << ": " << std::endl;
+
+        // Adjacency list.
+        for (CompactEdge edge : graph.getEdges(i))
+            std::cout << "  " << graph.getTag(edge.target) << " " << edge.weight << std::endl;
+    }
+}
+
 void printDijkstraTable(const Graph& graph, const DijkstraInfo* const dijkstraTable) {
     for (int i = 0; i < graph.vertexCount(); i++) {
         std::cout << graph.getVertices()[i].tag << ": " << ((dijkstraTable[i].predecessor == nullptr) ? "nullptr" : 
@@ -41,6 +53,13 @@ void printDijkstraTable(const Graph& graph, const DijkstraInfo* const dijkstraTa
     }
 }
 
+void printDijkstraTable(const CompactGraph& graph, const std::vector<DenseDijkstraInfo>& dijkstraTable) {
+    for (uint32_t i = 0; i < graph.vertexCount(); i++) {
+        std::cout << graph.getTag(i) << ": " << ((dijkstraTable[i].predecessor == CompactGraph::NO_VERTEX) ? 
+                "none" : graph.getTag(dijkstraTable[i].predecessor)) << ", " << dijkstraTable[i].cost << std::endl;
+    }
+}
+
 std::chrono::_V2::system_clock::time_point startTimer() {
     return std::chrono::high_resolution_clock::now();
 }
@@ -199,3 +218,85 @@ void graphDemo2() {
     printDijkstraTable(graph, dijkstraTable);
     delete[] dijkstraTable;
 }
+
+
+void compactGraphDemo() {
+    // Cities are interned once and referred to by id from then on.
+    CompactGraph graph;
+    const char* cities[] = {"Dublin", "London", "Paris", "Brussels", "Prague", "Bern", "Madrid"};
+    for (const char* city : cities)
+        graph.addVertex(city);
+
+    // Flights between them, in km.
+    graph.addEdge(graph.indexOfTag("Dublin"), graph.indexOfTag("London"), 464);
+    graph.addEdge(graph.indexOfTag("Dublin"), graph.indexOfTag("Paris"), 783);
+    graph.addEdge(graph.indexOfTag("London"), graph.indexOfTag("Paris"), 340);
+    graph.addEdge(graph.indexOfTag("London"), graph.indexOfTag("Brussels"), 320);
+    graph.addEdge(graph.indexOfTag("Brussels"), graph.indexOfTag("Prague"), 720);
+    graph.addEdge(graph.indexOfTag("Brussels"), graph.indexOfTag("Bern"), 489);
+    graph.addEdge(graph.indexOfTag("Brussels"), graph.indexOfTag("Paris"), 252);
+    graph.addEdge(graph.indexOfTag("Paris"), graph.indexOfTag("Bern"), 435);
+    graph.addEdge(graph.indexOfTag("Paris"), graph.indexOfTag("Madrid"), 1052);
+    graph.addEdge(graph.indexOfTag("Bern"), graph.indexOfTag("Madrid"), 1151);
+    graph.addEdge(graph.indexOfTag("Bern"), graph.indexOfTag("Prague"), 620);
+
+    // Print the graph.
+    std::cout << "Original graph:" << std::endl;
+    printGraph(graph);
+
+    // Print the minimum spanning tree.
+    std::cout << std::endl << "Minimum spanning tree:" << std::endl;
+    CompactGraph* mst = minimumSpanningTree(graph);
+    printGraph(*mst);
+    delete mst;
+
+    // Print the shortest paths from Dublin.
+    std::vector<DenseDijkstraInfo> dijkstraTable = singleSourceShortestPath(graph, graph.indexOfTag("Dublin"));
+    std::cout << std::endl << "Shortest paths from Dublin:" << std::endl;
+    printDijkstraTable(graph, dijkstraTable);
+}
+
+bool concurrentDisjointSetCheck(uint32_t elementCount, uint32_t unionCount, unsigned int threadCount) {
+    std::random_device randomDevice;
+    std::mt19937 generator(randomDevice());
+    std::uniform_int_distribution<uint32_t> distribution(0, elementCount - 1);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(unionCount);
+    for (std::pair<uint32_t, uint32_t>& pair : pairs)
+        pair = {distribution(generator), distribution(generator)};
+
+    // Every thread takes an interleaved share of the pairs, so they all work on the whole set at once.
+    threadCount = resolveThreadCount(threadCount);
+    ConcurrentDisjointSet concurrent(elementCount);
+    std::atomic<uint32_t> merges(0);
+    std::atomic<bool> consistent(true);
+    parallelFor(threadCount, threadCount, [&](size_t, size_t, unsigned int thread) {
+        uint32_t ownMerges = 0;
+        for (size_t i = thread; i < pairs.size(); i += threadCount) {
+            if (concurrent.unite(pairs[i].first, pairs[i].second))
+                ownMerges++;
+            // A united pair stays connected whatever the other threads do.
+            if (!concurrent.connected(pairs[i].first, pairs[i].second))
+                consistent.store(false, std::memory_order_relaxed);
+        }
+        merges.fetch_add(ownMerges, std::memory_order_relaxed);
+    });
+
+    DisjointSet sequential(elementCount);
+    for (const std::pair<uint32_t, uint32_t>& pair : pairs)
+        sequential.unite(pair.first, pair.second);
+
+    // The partitions match if both map roots one to one.
+    std::vector<uint32_t> rootOf(elementCount, UINT32_MAX);
+    bool same = consistent.load() && concurrent.setCount() == sequential.setCount() 
+        && merges.load() == elementCount - sequential.setCount();
+    for (uint32_t i = 0; i < elementCount && same; i++) {
+        uint32_t& root = rootOf[sequential.find(i)];
+        if (root == UINT32_MAX)
+            root = concurrent.find(i);
+        same = (root == concurrent.find(i));
+    }
+
+    std::cout << "Concurrent disjoint set, " << elementCount << " elements, " << unionCount << " unions on " 
+        << threadCount << " threads: " << (same ? "same sets as sequential" : "MISMATCH") << std::endl;
+    return same;
+}
@@ -7,8 +7,10 @@
 #include "circular-array.h"
 #include "linked-list.h"
 #include "graph.h"
+#include "compact-graph.h"
 #include "graph-algorithms.h"
 #include "alphabet-set.h"
+#include "disjoint-set.h"
 
 /**
  * @brief Creates an array of random integer values in a range.
@@ -77,6 +79,13 @@ void printLinkedList(const LinkedList<T>& linkedList) {
  */
 void printGraph(const Graph& graph);
 
+/**
+ * @brief Prints the vertices and edges of an undirected compact graph.
+ * 
+ * @param graph the graph to print out
+ */
+void printGraph(const CompactGraph& graph);
+
 /**
  * @brief Prints the contents of a Dijkstra table.
  * 
@@ -85,6 +94,14 @@ void printGraph(const Graph& graph);
  */
 void printDijkstraTable(const Graph& graph, const DijkstraInfo* const dijkstraTable);
 
+/**
+ * @brief Prints the contents of a Dijkstra table computed on a compact graph.
+ * 
+ * @param graph the original graph
+ * @param dijkstraTable the dijkstra table
+ */
+void printDijkstraTable(const CompactGraph& graph, const std::vector<DenseDijkstraInfo>& dijkstraTable);
+
 /**
  * @brief Semantically, returns the start time of a timer. This is used as a point of reference for stopTimer().
  * 
@@ -121,3 +138,20 @@ void graphDemo1();
  * @brief Minimum spanning tree and Dijkstra's algorithm on a graph of a few real-world locations.
  */
 void graphDemo2();
+
+/**
+ * @brief The graph from graphDemo2(), built directly in compact storage from tags and vertex ids.
+ */
+void compactGraphDemo();
+
+/**
+ * @brief A stress check of ConcurrentDisjointSet. Several threads unite random pairs of a small set of elements, so that 
+ * their finds and unions keep racing on the same paths, and query it at the same time; the resulting sets are then 
+ * compared with a sequential DisjointSet given the same pairs.
+ * 
+ * @param elementCount how many elements there are
+ * @param unionCount how many random pairs to unite
+ * @param threadCount how many threads to use, or 0 for the hardware concurrency
+ * @return bool true if both disjoint sets ended with the same sets
+ */
+bool concurrentDisjointSetCheck(uint32_t elementCount, uint32_t unionCount, unsigned int threadCount);
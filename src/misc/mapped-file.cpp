@@ -0,0 +1,65 @@
+#include "mapped-file.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <cstdlib>
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+    _address = nullptr;
+    _size = 0;
+
+#ifdef _WIN32
+    // No mmap here, so read the whole file instead.
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + ".");
+    _size = file.tellg();
+    if (_size > 0) {
+        _address = std::malloc(_size);
+        file.seekg(0);
+        file.read(static_cast<char*>(_address), _size);
+    }
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("Could not open " + path + ".");
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw std::runtime_error("Could not stat " + path + ".");
+    }
+    _size = status.st_size;
+    if (_size > 0)
+        _address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor); // The mapping keeps the file alive.
+    if (_address == MAP_FAILED) {
+        _address = nullptr;
+        throw std::runtime_error("Could not map " + path + ".");
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+    if (_address == nullptr)
+        return;
+#ifdef _WIN32
+    std::free(_address);
+#else
+    munmap(_address, _size);
+#endif
+}
+
+const char* MappedFile::getData() const {
+    return static_cast<const char*>(_address);
+}
+
+size_t MappedFile::getSize() const {
+    return _size;
+}
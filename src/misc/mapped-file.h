@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A whole file mapped read-only into memory. Pages are read from disk the first time they are touched. On 
+ * platforms without mmap the file is read into memory up front instead.
+ */
+class MappedFile {
+private:
+    void* _address;
+    size_t _size;
+
+public:
+    /**
+     * @brief Maps a file. Throws std::runtime_error if it cannot be opened or mapped.
+     * 
+     * @param path the file to map
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    /**
+     * @brief Unmaps the file. Pointers returned by getData() must not be used afterwards.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Returns the start of the file's contents, or nullptr if the file is empty.
+     * 
+     * @return const char* the file's contents
+     */
+    const char* getData() const;
+
+    size_t getSize() const;
+};
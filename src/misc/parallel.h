@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns how many threads to use when the caller asked for 0 ("pick for me").
+ * 
+ * @param requested how many threads the caller asked for, or 0
+ * @return unsigned int requested if non-zero, otherwise the hardware concurrency (at least 1)
+ */
+inline unsigned int resolveThreadCount(unsigned int requested) {
+    if (requested != 0)
+        return requested;
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return (hardware == 0) ? 1 : hardware;
+}
+
+/**
+ * @brief Splits [0, count) into threadCount contiguous chunks and runs body(begin, end, threadIndex) on each chunk in 
+ * its own thread. The calling thread runs the first chunk itself. Returns once every chunk is done.
+ * 
+ * @tparam F callable as body(size_t begin, size_t end, unsigned int threadIndex)
+ * @param count how many items there are
+ * @param threadCount how many chunks (and threads) to use
+ * @param body the work to do on one chunk
+ */
+template <typename F>
+void parallelFor(size_t count, unsigned int threadCount, F body) {
+    if (threadCount <= 1 || count <= 1) {
+        body(0, count, 0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned int t = 1; t < threadCount; t++)
+        threads.emplace_back(body, count * t / threadCount, count * (t + 1) / threadCount, t);
+    body(0, count / threadCount, 0);
+    for (int i = 0; i < threads.size(); i++)
+        threads[i].join();
+}
+
+/**
+ * @brief Runs body(threadIndex) once on each of threadCount threads. The calling thread is thread 0. Returns once every 
+ * thread is done. Unlike parallelFor, the threads live for the whole body, so they can take many steps together with 
+ * a Barrier without being started again for every step.
+ * 
+ * @tparam F callable as body(unsigned int threadIndex)
+ * @param threadCount how many threads to use
+ * @param body the work of one thread
+ */
+template <typename F>
+void parallelRegion(unsigned int threadCount, F body) {
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned int t = 1; t < threadCount; t++)
+        threads.emplace_back(body, t);
+    body(0);
+    for (int i = 0; i < threads.size(); i++)
+        threads[i].join();
+}
+
+/**
+ * @brief Makes a fixed number of threads wait for each other. Reusable: once every thread has arrived, all of them 
+ * continue and the barrier is ready for the next step.
+ */
+class Barrier {
+private:
+    std::mutex _mutex;
+    std::condition_variable _allArrived;
+    unsigned int _threadCount;
+    unsigned int _waiting;
+    unsigned long _generation;
+
+public:
+    explicit Barrier(unsigned int threadCount) : _threadCount(threadCount), _waiting(0), _generation(0) {}
+
+    Barrier(const Barrier& other) = delete;
+    Barrier& operator=(const Barrier& other) = delete;
+
+    /**
+     * @brief Blocks until every thread has called wait() for this step. Everything a thread wrote before its call is 
+     * visible to every thread after theirs.
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        unsigned long generation = _generation;
+        if (++_waiting == _threadCount) {
+            _waiting = 0;
+            _generation++;
+            _allArrived.notify_all();
+            return;
+        }
+        _allArrived.wait(lock, [&] { return _generation != generation; });
+    }
+};